@@ -26,5 +26,8 @@ public class PlayerMoveTo : ModuleRules
 				"AIModule",
 			}
 			);
+
+		// Dedicated servers have nobody to show visual logger and message log output to
+		PrivateDefinitions.Add("WITH_PLAYERMOVETO_DEBUG=" + (Target.Type == TargetType.Server ? "0" : "1"));
 	}
 }
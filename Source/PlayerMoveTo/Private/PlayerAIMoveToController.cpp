@@ -3,11 +3,34 @@
 
 #include "PlayerAIMoveToController.h"
 
+#include "PlayerMoveToStats.h"
 #include "GameplayTasksComponent.h"
+#include "Navigation/PathFollowingComponent.h"
 #include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerAIMoveToController)
 
+namespace PlayerMoveToCVars
+{
+	static float PredictionStartTolerance = 300.f;
+	FAutoConsoleVariableRef CVarPredictionStartTolerance(
+		TEXT("PlayerMoveTo.Prediction.StartTolerance"),
+		PredictionStartTolerance,
+		TEXT("Distance between start of predicted path and pawn on the server above which the path is rejected"),
+		ECVF_Default);
+
+	static bool bPredictionValidateSegments = true;
+	FAutoConsoleVariableRef CVarPredictionValidateSegments(
+		TEXT("PlayerMoveTo.Prediction.ValidateSegments"),
+		bPredictionValidateSegments,
+		TEXT("Server raycasts every segment of predicted paths on its navigation, otherwise only their points are projected. Disable for paths using navigation links"),
+		ECVF_Default);
+}
+
 UGameplayTasksComponent* APlayerAIMoveToController::GetGameplayTasksComponent(const UGameplayTask& Task) const
 {
 	return GetGameplayTasksComponent();
@@ -44,9 +67,150 @@ void APlayerAIMoveToController::CacheGameplayTasksComponent(APawn* InPawn)
 	}
 }
 
+void APlayerAIMoveToController::ServerSetPredictedPath_Implementation(const FPlayerMovePathDigest& Digest)
+{
+	if (ValidatePredictedPath(Digest))
+	{
+		INC_DWORD_STAT(STAT_PlayerMoveTo_PredictedPathsAccepted);
+		PredictedPath = Digest;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PlayerMoveTo_PredictedPathsRejected);
+		PredictedPath = FPlayerMovePathDigest();
+		ClientRejectPredictedPath(Digest.MoveId);
+	}
+}
+
+void APlayerAIMoveToController::ServerClearPredictedPath_Implementation(uint32 MoveId)
+{
+	if (PredictedPath.MoveId == MoveId)
+	{
+		PredictedPath = FPlayerMovePathDigest();
+	}
+}
+
+void APlayerAIMoveToController::ClientRejectPredictedPath_Implementation(uint32 MoveId)
+{
+	OnPredictedPathRejected.Broadcast(MoveId);
+}
+
+void APlayerAIMoveToController::ClientSetFollowedPath_Implementation(const FPlayerMoveNetPath& NetPath)
+{
+	if (NetPath.MoveId != ReplicatedPathMoveId || NetPath.StartIndex < ReplicatedPathStartIndex ||
+		NetPath.FirstPointIndex > ReplicatedPathStartIndex + ReplicatedPathPoints.Num())
+	{
+		// new move, new path of the same move, or an update of one whose start we never got
+		ReplicatedPathPoints.Reset();
+		ReplicatedPathStartIndex = NetPath.StartIndex;
+		if (NetPath.FirstPointIndex > NetPath.StartIndex)
+		{
+			return;
+		}
+	}
+
+	// window moved forward, points pawn passed are dropped
+	ReplicatedPathPoints.RemoveAt(0, FMath::Min(NetPath.StartIndex - ReplicatedPathStartIndex, ReplicatedPathPoints.Num()));
+	ReplicatedPathStartIndex = NetPath.StartIndex;
+
+	ReplicatedPathMoveId = NetPath.MoveId;
+	ReplicatedPathPoints.SetNum(NetPath.FirstPointIndex - NetPath.StartIndex);
+	ReplicatedPathPoints.Append(NetPath.PathPoints);
+	OnFollowedPathReplicated.Broadcast(ReplicatedPathPoints);
+}
+
+void APlayerAIMoveToController::ClientClearFollowedPath_Implementation(uint32 MoveId)
+{
+	if (MoveId == ReplicatedPathMoveId)
+	{
+		ReplicatedPathMoveId = 0;
+		ReplicatedPathStartIndex = 0;
+		ReplicatedPathPoints.Reset();
+		OnFollowedPathReplicated.Broadcast(ReplicatedPathPoints);
+	}
+}
+
+bool APlayerAIMoveToController::ValidatePredictedPath(const FPlayerMovePathDigest& Digest) const
+{
+	PLAYERMOVETO_SCOPE(PredictionValidation);
+
+	if (!Digest.IsValid() || GetPawn() == nullptr)
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(Digest.PathPoints[0], GetNavAgentLocation()) > FMath::Square(PlayerMoveToCVars::PredictionStartTolerance))
+	{
+		return false;
+	}
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(GetNavAgentPropertiesRef(), GetNavAgentLocation()) : nullptr;
+	if (NavData == nullptr)
+	{
+		return false;
+	}
+
+	// validation cost is bounded, clients only send this many points anyway
+	const int32 NumPoints = FMath::Min(Digest.PathPoints.Num(), FPlayerMovePathDigest::GetMaxPathPoints());
+	// a permissive filter sent by a cheating client would let paths through anything
+	const TSubclassOf<UNavigationQueryFilter> FilterClass = PredictionFilterClasses.Contains(Digest.FilterClass) ? Digest.FilterClass : nullptr;
+	const FSharedConstNavQueryFilter NavFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, this, FilterClass);
+
+	// string pulled path stays on navigation between its points, much cheaper to test than searching it
+	if (PlayerMoveToCVars::bPredictionValidateSegments && NumPoints > 1)
+	{
+		TArray<FNavigationRaycastWork> Workload;
+		Workload.Reserve(NumPoints - 1);
+		for (int32 Index = 1; Index < NumPoints; Index++)
+		{
+			Workload.Emplace(Digest.PathPoints[Index - 1], Digest.PathPoints[Index]);
+		}
+
+		NavData->BatchRaycast(Workload, NavFilter, this);
+		return !Workload.ContainsByPredicate([](const FNavigationRaycastWork& Work) { return Work.bDidHit; });
+	}
+
+	TArray<FNavigationProjectionWork> Workload;
+	Workload.Reserve(NumPoints);
+	for (int32 Index = 0; Index < NumPoints; Index++)
+	{
+		Workload.Emplace(Digest.PathPoints[Index]);
+	}
+
+	NavData->BatchProjectPoints(Workload, NavData->GetDefaultQueryExtent(), NavFilter, this);
+	return !Workload.ContainsByPredicate([](const FNavigationProjectionWork& Work) { return !Work.bResult; });
+}
+
+void APlayerAIMoveToController::CachePathFollowingComponent()
+{
+	if (CachedPathFollowingComponent == nullptr)
+	{
+		UPathFollowingComponent* PFComp = FindComponentByClass<UPathFollowingComponent>();
+		if (PFComp == nullptr)
+		{
+			UClass* PFCompClass = PathFollowingComponentClass ? PathFollowingComponentClass.Get() : UPathFollowingComponent::StaticClass();
+			PFComp = NewObject<UPathFollowingComponent>(this, PFCompClass, TEXT("PathFollowingComponent"));
+			PFComp->RegisterComponent();
+		}
+		CachedPathFollowingComponent = PFComp;
+	}
+
+	// picks up movement component of possessed pawn
+	CachedPathFollowingComponent->Initialize();
+}
+
+void APlayerAIMoveToController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CachePathFollowingComponent();
+}
+
 void APlayerAIMoveToController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 
 	CacheGameplayTasksComponent(InPawn);
+	CachePathFollowingComponent();
 }
@@ -1,9 +1,39 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "PlayerMoveTo.h"
+#include "PlayerMoveToStats.h"
 
 #define LOCTEXT_NAMESPACE "FPlayerMoveToModule"
 
+DEFINE_STAT(STAT_PlayerMoveTo_PerformMove);
+DEFINE_STAT(STAT_PlayerMoveTo_GoalProjection);
+DEFINE_STAT(STAT_PlayerMoveTo_QueryBuilding);
+DEFINE_STAT(STAT_PlayerMoveTo_PathCacheLookup);
+DEFINE_STAT(STAT_PlayerMoveTo_PathSearch);
+DEFINE_STAT(STAT_PlayerMoveTo_BatchPathSearch);
+DEFINE_STAT(STAT_PlayerMoveTo_WorkerPathSearch);
+DEFINE_STAT(STAT_PlayerMoveTo_WorkerJoin);
+DEFINE_STAT(STAT_PlayerMoveTo_RequestMove);
+DEFINE_STAT(STAT_PlayerMoveTo_Repath);
+DEFINE_STAT(STAT_PlayerMoveTo_PathRepair);
+DEFINE_STAT(STAT_PlayerMoveTo_GoalTracking);
+DEFINE_STAT(STAT_PlayerMoveTo_RouteLeg);
+DEFINE_STAT(STAT_PlayerMoveTo_NearestGoalSelection);
+DEFINE_STAT(STAT_PlayerMoveTo_Reachability);
+DEFINE_STAT(STAT_PlayerMoveTo_PredictionValidation);
+DEFINE_STAT(STAT_PlayerMoveTo_PathSmoothing);
+DEFINE_STAT(STAT_PlayerMoveTo_ActiveTasks);
+DEFINE_STAT(STAT_PlayerMoveTo_MoveRetries);
+DEFINE_STAT(STAT_PlayerMoveTo_RepathRetries);
+DEFINE_STAT(STAT_PlayerMoveTo_TaskPoolHits);
+DEFINE_STAT(STAT_PlayerMoveTo_TaskPoolMisses);
+DEFINE_STAT(STAT_PlayerMoveTo_TaskPoolFree);
+DEFINE_STAT(STAT_PlayerMoveTo_PredictedPathsAccepted);
+DEFINE_STAT(STAT_PlayerMoveTo_PredictedPathsRejected);
+
+TRACE_DECLARE_INT_COUNTER(PlayerMoveTo_ActiveTasks, TEXT("PlayerMoveTo/ActiveTasks"));
+TRACE_DECLARE_INT_COUNTER(PlayerMoveTo_Retries, TEXT("PlayerMoveTo/Retries"));
+
 void FPlayerMoveToModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -0,0 +1,300 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToCacheSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#if WITH_RECAST
+#include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToCacheSubsystem)
+
+namespace PlayerMoveToCVars
+{
+	static bool bEnablePathCache = true;
+	FAutoConsoleVariableRef CVarEnablePathCache(
+		TEXT("PlayerMoveTo.PathCache.Enable"),
+		bEnablePathCache,
+		TEXT("Reuse path corridors of previous player move requests with the same quantized start and goal"),
+		ECVF_Default);
+
+	static float PathCacheQuantization = 50.f;
+	FAutoConsoleVariableRef CVarPathCacheQuantization(
+		TEXT("PlayerMoveTo.PathCache.Quantization"),
+		PathCacheQuantization,
+		TEXT("Size of the grid cell start and goal locations are snapped to when looking up cached paths"),
+		ECVF_Default);
+
+	static int32 PathCacheMaxEntries = 256;
+	FAutoConsoleVariableRef CVarPathCacheMaxEntries(
+		TEXT("PlayerMoveTo.PathCache.MaxEntries"),
+		PathCacheMaxEntries,
+		TEXT("Maximum number of cached paths per world, least recently used are dropped first"),
+		ECVF_Default);
+
+	static float PathCacheMaxAge = 60.f;
+	FAutoConsoleVariableRef CVarPathCacheMaxAge(
+		TEXT("PlayerMoveTo.PathCache.MaxAge"),
+		PathCacheMaxAge,
+		TEXT("Seconds a cached path can go unused before it is dropped"),
+		ECVF_Default);
+
+	static int32 ProjectionCacheMaxEntries = 64;
+	FAutoConsoleVariableRef CVarProjectionCacheMaxEntries(
+		TEXT("PlayerMoveTo.ProjectionCache.MaxEntries"),
+		ProjectionCacheMaxEntries,
+		TEXT("Number of most recent goal projections reused by player move requests per world, 0 = disabled"),
+		ECVF_Default);
+
+	static float ProjectionCacheMaxAge = 5.f;
+	FAutoConsoleVariableRef CVarProjectionCacheMaxAge(
+		TEXT("PlayerMoveTo.ProjectionCache.MaxAge"),
+		ProjectionCacheMaxAge,
+		TEXT("Seconds a cached goal projection is reused for, navmesh changes under it are not detected"),
+		ECVF_Default);
+
+	static float ProjectionCacheQuantization = 10.f;
+	FAutoConsoleVariableRef CVarProjectionCacheQuantization(
+		TEXT("PlayerMoveTo.ProjectionCache.Quantization"),
+		ProjectionCacheQuantization,
+		TEXT("Size of the grid cell goal locations are snapped to when looking up cached projections"),
+		ECVF_Default);
+}
+
+namespace PlayerMoveToCache
+{
+	static FIntVector Quantize(const FVector& Location, float CellSize = PlayerMoveToCVars::PathCacheQuantization)
+	{
+		const double Cell = FMath::Max(1.0, (double)CellSize);
+		return FIntVector(FMath::FloorToInt(Location.X / Cell), FMath::FloorToInt(Location.Y / Cell), FMath::FloorToInt(Location.Z / Cell));
+	}
+
+#if WITH_RECAST
+	/** creates a mesh path over Source's corridor, string pulled between Start and End
+	 *  @param bRegister - register with the navmesh so it receives invalidation, only paths handed to a move need it
+	 */
+	static FNavPathSharedPtr CreateCorridorPath(ARecastNavMesh& NavMesh, const FNavMeshPath& Source, const FVector& Start, const FVector& End, const UObject* Querier, bool bRegister)
+	{
+		FNavMeshPath* MeshPath = new FNavMeshPath();
+		FNavPathSharedPtr NewPath = MakeShareable(MeshPath);
+
+		MeshPath->SetNavigationDataUsed(&NavMesh);
+		MeshPath->SetQuerier(Querier);
+		MeshPath->SetTimeStamp(NavMesh.GetWorldTimeStamp());
+		MeshPath->PathCorridor = Source.PathCorridor;
+		MeshPath->PathCorridorCost = Source.PathCorridorCost;
+		MeshPath->CustomLinkIds = Source.CustomLinkIds;
+		MeshPath->PerformStringPulling(Start, End);
+		MeshPath->MarkReady();
+
+		if (bRegister)
+		{
+			NavMesh.RegisterActivePath(NewPath);
+		}
+		return NewPath;
+	}
+
+	/** cached entries aren't registered with the navmesh, tile rebuilds are detected by their polys going stale */
+	static bool IsCorridorValid(const ARecastNavMesh& NavMesh, const FNavMeshPath& MeshPath)
+	{
+		for (const NavNodeRef PolyRef : MeshPath.PathCorridor)
+		{
+			if (!NavMesh.IsNodeRefValid(PolyRef))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+#endif
+}
+
+FPlayerMovePathCacheKey::FPlayerMovePathCacheKey(const FPathFindingQuery& Query, const FNavAgentProperties& AgentProps,
+	TSubclassOf<UNavigationQueryFilter> InFilterClass)
+	: Start(PlayerMoveToCache::Quantize(Query.StartLocation))
+	, Goal(PlayerMoveToCache::Quantize(Query.EndLocation))
+	, NavData(Query.NavData.Get())
+	, AgentHash(HashCombine(GetTypeHash(AgentProps.AgentRadius), GetTypeHash(AgentProps.AgentHeight)))
+	, FilterClass(InFilterClass.Get())
+{
+}
+
+UPlayerMoveToCacheSubsystem* UPlayerMoveToCacheSubsystem::Get(const UWorld* World)
+{
+	return World && PlayerMoveToCVars::bEnablePathCache ? World->GetSubsystem<UPlayerMoveToCacheSubsystem>() : nullptr;
+}
+
+FNavPathSharedPtr UPlayerMoveToCacheSubsystem::FindPath(const FPlayerMovePathCacheKey& Key, const FPathFindingQuery& Query)
+{
+#if WITH_RECAST
+	FCachedPath* Entry = Key.IsValid() ? PathCache.Find(Key) : nullptr;
+	if (Entry == nullptr)
+	{
+		NumMisses++;
+		return nullptr;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FNavMeshPath* CachedPath = Entry->Path.IsValid() ? Entry->Path->CastPath<FNavMeshPath>() : nullptr;
+	ARecastNavMesh* NavMesh = CachedPath ? Cast<ARecastNavMesh>(CachedPath->GetNavigationDataUsed()) : nullptr;
+
+	// navmesh under the path was rebuilt, or nobody needed it for a while
+	if (NavMesh == nullptr || !CachedPath->IsValid() || Now - Entry->LastUsedTime > PlayerMoveToCVars::PathCacheMaxAge
+		|| !PlayerMoveToCache::IsCorridorValid(*NavMesh, *CachedPath))
+	{
+		PathCache.Remove(Key);
+		NumMisses++;
+		return nullptr;
+	}
+
+	// quantization can map a location onto a neighbouring poly, corridor is only valid if both ends are on it
+	const FVector Extent = NavMesh->GetDefaultQueryExtent();
+	const NavNodeRef StartPoly = NavMesh->FindNearestPoly(Query.StartLocation, Extent, Query.QueryFilter, Query.Owner.Get());
+	const NavNodeRef GoalPoly = NavMesh->FindNearestPoly(Query.EndLocation, Extent, Query.QueryFilter, Query.Owner.Get());
+	if (StartPoly != CachedPath->PathCorridor[0] || GoalPoly != CachedPath->PathCorridor.Last())
+	{
+		NumMisses++;
+		return nullptr;
+	}
+
+	FNavPathSharedPtr NewPath = PlayerMoveToCache::CreateCorridorPath(*NavMesh, *CachedPath, Query.StartLocation, Query.EndLocation, Query.Owner.Get(), true);
+	if (!NewPath->IsValid())
+	{
+		NumMisses++;
+		return nullptr;
+	}
+
+	NewPath->SetQueryData(Query);
+
+	Entry->LastUsedTime = Now;
+	NumHits++;
+	return NewPath;
+#else
+	NumMisses++;
+	return nullptr;
+#endif
+}
+
+void UPlayerMoveToCacheSubsystem::AddPath(const FPlayerMovePathCacheKey& Key, const FNavPathSharedPtr& InPath)
+{
+#if WITH_RECAST
+	// only full navmesh paths are worth sharing, partial ones depend on search limits
+	const FNavMeshPath* MeshPath = Key.IsValid() && InPath.IsValid() ? InPath->CastPath<FNavMeshPath>() : nullptr;
+	ARecastNavMesh* NavMesh = MeshPath ? Cast<ARecastNavMesh>(MeshPath->GetNavigationDataUsed()) : nullptr;
+	if (NavMesh == nullptr || MeshPath->IsPartial() || MeshPath->PathCorridor.Num() == 0 || MeshPath->GetPathPoints().Num() < 2)
+	{
+		return;
+	}
+
+	if (!PathCache.Contains(Key))
+	{
+		TrimPathCache(PlayerMoveToCVars::PathCacheMaxEntries - 1);
+	}
+
+	FCachedPath& Entry = PathCache.FindOrAdd(Key);
+	Entry.Path = PlayerMoveToCache::CreateCorridorPath(*NavMesh, *MeshPath, MeshPath->GetStartLocation(), MeshPath->GetEndLocation(), this, false);
+	Entry.LastUsedTime = GetWorld()->GetTimeSeconds();
+#endif
+}
+
+void UPlayerMoveToCacheSubsystem::FlushPaths()
+{
+	PathCache.Reset();
+	ProjectionCache.Reset();
+}
+
+bool UPlayerMoveToCacheSubsystem::FindProjection(const ANavigationData* NavData, const FVector& Goal, FNavLocation& OutLocation)
+{
+	if (NavData == nullptr || PlayerMoveToCVars::ProjectionCacheMaxEntries <= 0)
+	{
+		return false;
+	}
+
+	const FProjectionKey Key{ NavData, PlayerMoveToCache::Quantize(Goal, PlayerMoveToCVars::ProjectionCacheQuantization) };
+	const FCachedProjection* Entry = ProjectionCache.Find(Key);
+	if (Entry == nullptr || GetWorld()->GetTimeSeconds() - Entry->AddedTime > PlayerMoveToCVars::ProjectionCacheMaxAge)
+	{
+		NumProjectionMisses++;
+		return false;
+	}
+
+	OutLocation = Entry->Location;
+	NumProjectionHits++;
+	return true;
+}
+
+void UPlayerMoveToCacheSubsystem::AddProjection(const ANavigationData* NavData, const FVector& Goal, const FNavLocation& Location)
+{
+	if (NavData == nullptr || PlayerMoveToCVars::ProjectionCacheMaxEntries <= 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FProjectionKey Key{ NavData, PlayerMoveToCache::Quantize(Goal, PlayerMoveToCVars::ProjectionCacheQuantization) };
+	if (!ProjectionCache.Contains(Key))
+	{
+		// expired entries first, then the oldest ones
+		for (auto It = ProjectionCache.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value().AddedTime > PlayerMoveToCVars::ProjectionCacheMaxAge)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		while (ProjectionCache.Num() > 0 && ProjectionCache.Num() >= PlayerMoveToCVars::ProjectionCacheMaxEntries)
+		{
+			FProjectionKey OldestKey;
+			double OldestTime = TNumericLimits<double>::Max();
+			for (const TPair<FProjectionKey, FCachedProjection>& Pair : ProjectionCache)
+			{
+				if (Pair.Value.AddedTime < OldestTime)
+				{
+					OldestKey = Pair.Key;
+					OldestTime = Pair.Value.AddedTime;
+				}
+			}
+			ProjectionCache.Remove(OldestKey);
+		}
+	}
+
+	FCachedProjection& Entry = ProjectionCache.FindOrAdd(Key);
+	Entry.Location = Location;
+	Entry.AddedTime = Now;
+}
+
+void UPlayerMoveToCacheSubsystem::TrimPathCache(int32 MaxEntries)
+{
+	while (PathCache.Num() > 0 && PathCache.Num() > MaxEntries)
+	{
+		FPlayerMovePathCacheKey OldestKey;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const TPair<FPlayerMovePathCacheKey, FCachedPath>& Pair : PathCache)
+		{
+			if (Pair.Value.LastUsedTime < OldestTime)
+			{
+				OldestKey = Pair.Key;
+				OldestTime = Pair.Value.LastUsedTime;
+			}
+		}
+		PathCache.Remove(OldestKey);
+	}
+}
+
+void UPlayerMoveToCacheSubsystem::Deinitialize()
+{
+	FlushPaths();
+
+	Super::Deinitialize();
+}
+
+bool UPlayerMoveToCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
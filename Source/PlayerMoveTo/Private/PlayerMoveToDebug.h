@@ -0,0 +1,25 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "VisualLogger/VisualLogger.h"
+
+/**
+ * Visual logger and message log output of the plugin
+ * Compiled out of dedicated server targets by PlayerMoveTo.Build.cs, there is nobody there to look at it
+ */
+#ifndef WITH_PLAYERMOVETO_DEBUG
+#define WITH_PLAYERMOVETO_DEBUG 1
+#endif
+
+#if WITH_PLAYERMOVETO_DEBUG
+#define PLAYERMOVETO_VLOG(...) UE_VLOG(__VA_ARGS__)
+#define PLAYERMOVETO_CVLOG(...) UE_CVLOG(__VA_ARGS__)
+#define PLAYERMOVETO_VLOG_LOCATION(...) UE_VLOG_LOCATION(__VA_ARGS__)
+#define PLAYERMOVETO_VLOG_SEGMENT(...) UE_VLOG_SEGMENT(__VA_ARGS__)
+#else
+#define PLAYERMOVETO_VLOG(...)
+#define PLAYERMOVETO_CVLOG(...)
+#define PLAYERMOVETO_VLOG_LOCATION(...)
+#define PLAYERMOVETO_VLOG_SEGMENT(...)
+#endif
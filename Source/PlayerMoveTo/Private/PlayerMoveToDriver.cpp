@@ -0,0 +1,2491 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PlayerMoveToDriver.h"
+#include "PlayerMoveToQuerySubsystem.h"
+#include "PlayerMoveToNavReadySubsystem.h"
+#include "PlayerMoveToPathFollowingProvider.h"
+#include "PlayerAIMoveToController.h"
+#include "TimerManager.h"
+#include "AISystem.h"
+#include "AIController.h"
+#include "PlayerMoveToDebug.h"
+#include "PlayerMoveToStats.h"
+#include "PlayerMoveToPathSmoothing.h"
+#include "GameplayTask.h"
+#include "GameplayTasksComponent.h"
+#include "NavigationSystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#if WITH_RECAST
+#include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToDriver)
+
+namespace PlayerMoveToCVars
+{
+	static bool bParallelBatchPathfinding = true;
+	FAutoConsoleVariableRef CVarParallelBatchPathfinding(
+		TEXT("PlayerMoveTo.Batch.ParallelPathfinding"),
+		bParallelBatchPathfinding,
+		TEXT("Run path searches of batched player move requests in parallel on worker threads"),
+		ECVF_Default);
+
+	static float BatchStartTolerance = 50.f;
+	FAutoConsoleVariableRef CVarBatchStartTolerance(
+		TEXT("PlayerMoveTo.Batch.StartTolerance"),
+		BatchStartTolerance,
+		TEXT("Horizontal distance pawn can move away from the start of its batched path before the task is activated, further away the path is searched again"),
+		ECVF_Default);
+
+	static int32 PathfindingMode = 0;
+	FAutoConsoleVariableRef CVarPathfindingMode(
+		TEXT("PlayerMoveTo.PathfindingMode"),
+		PathfindingMode,
+		TEXT("How player move requests search for paths\n")
+		TEXT("0: per task, async queue if the task uses async pathfinding otherwise sync (default)\n")
+		TEXT("1: sync, on game thread\n")
+		TEXT("2: worker, on task graph workers, joined at end of frame\n")
+		TEXT("3: async queue, on navigation system's async queue"),
+		ECVF_Default);
+
+	static float GoalProjectionHorizontalExtent = 0.f;
+	FAutoConsoleVariableRef CVarGoalProjectionHorizontalExtent(
+		TEXT("PlayerMoveTo.GoalProjection.HorizontalExtent"),
+		GoalProjectionHorizontalExtent,
+		TEXT("Horizontal extent of goal projection onto navigation, tighter extent is cheaper. 0 = navigation data's default query extent"),
+		ECVF_Default);
+
+	static float GoalProjectionVerticalExtent = 0.f;
+	FAutoConsoleVariableRef CVarGoalProjectionVerticalExtent(
+		TEXT("PlayerMoveTo.GoalProjection.VerticalExtent"),
+		GoalProjectionVerticalExtent,
+		TEXT("Vertical extent of goal projection onto navigation, tighter extent is cheaper. 0 = navigation data's default query extent"),
+		ECVF_Default);
+
+	static int32 NetPathMaxPoints = 32;
+	FAutoConsoleVariableRef CVarNetPathMaxPoints(
+		TEXT("PlayerMoveTo.NetPath.MaxPoints"),
+		NetPathMaxPoints,
+		TEXT("Maximum number of path points replicated to the owning client, longer paths are sent in windows ahead of the pawn"),
+		ECVF_Default);
+
+	static float PredictionReportInterval = 0.25f;
+	FAutoConsoleVariableRef CVarPredictionReportInterval(
+		TEXT("PlayerMoveTo.Prediction.ReportInterval"),
+		PredictionReportInterval,
+		TEXT("Minimum time between updates of a predicted move's path sent to the server, path changes in between are sent once it passes. New moves are sent right away"),
+		ECVF_Default);
+
+	static float FollowInterval = 0.1f;
+	FAutoConsoleVariableRef CVarFollowInterval(
+		TEXT("PlayerMoveTo.Follow.Interval"),
+		FollowInterval,
+		TEXT("How often moves to a goal actor check whether it moved since the followed path was found, in seconds"),
+		ECVF_Default);
+
+	static bool bRepairPaths = true;
+	FAutoConsoleVariableRef CVarRepairPaths(
+		TEXT("PlayerMoveTo.Repath.Repair"),
+		bRepairPaths,
+		TEXT("Repair invalidated paths by keeping the part that is still walkable and only searching from its end to the goal, instead of repathing from the pawn"),
+		ECVF_Default);
+
+	static int32 FollowMaxExtensions = 4;
+	FAutoConsoleVariableRef CVarFollowMaxExtensions(
+		TEXT("PlayerMoveTo.Follow.MaxExtensions"),
+		FollowMaxExtensions,
+		TEXT("Number of times followed path can be extended in a straight line towards the goal actor before a new path is searched"),
+		ECVF_Default);
+
+	static float RouteLegDistance = 10000.f;
+	FAutoConsoleVariableRef CVarRouteLegDistance(
+		TEXT("PlayerMoveTo.Hierarchical.LegDistance"),
+		RouteLegDistance,
+		TEXT("Length of route legs searched by hierarchical moves, moves to closer goals search a single path. 0 = hierarchical moves disabled"),
+		ECVF_Default);
+
+	static float RouteRefineDistance = 5000.f;
+	FAutoConsoleVariableRef CVarRouteRefineDistance(
+		TEXT("PlayerMoveTo.Hierarchical.RefineDistance"),
+		RouteRefineDistance,
+		TEXT("Next route leg of hierarchical moves is searched once the pawn is this close to the end of the followed path"),
+		ECVF_Default);
+
+	static float StreamingProbeStep = 2000.f;
+	FAutoConsoleVariableRef CVarStreamingProbeStep(
+		TEXT("PlayerMoveTo.Streaming.ProbeStep"),
+		StreamingProbeStep,
+		TEXT("Spacing of points tested for loaded navigation between the pawn and a goal that isn't loaded yet, when looking for the closest reachable spot"),
+		ECVF_Default);
+
+	static int32 StreamingMaxProbes = 16;
+	FAutoConsoleVariableRef CVarStreamingMaxProbes(
+		TEXT("PlayerMoveTo.Streaming.MaxProbes"),
+		StreamingMaxProbes,
+		TEXT("Maximum number of points tested for loaded navigation towards a goal that isn't loaded yet, spacing grows on long distances"),
+		ECVF_Default);
+}
+
+namespace PlayerMoveToDriver
+{
+	enum class EPathfindingMode : uint8
+	{
+		Sync,
+		Worker,
+		AsyncQueue,
+	};
+
+	static EPathfindingMode GetPathfindingMode(bool bUseAsyncPathfinding)
+	{
+		switch (PlayerMoveToCVars::PathfindingMode)
+		{
+		case 1: return EPathfindingMode::Sync;
+		case 2: return EPathfindingMode::Worker;
+		case 3: return EPathfindingMode::AsyncQueue;
+		default: return bUseAsyncPathfinding ? EPathfindingMode::AsyncQueue : EPathfindingMode::Sync;
+		}
+	}
+
+	/** @return lowest cost per unit of distance of any area of Filter, straight line distance times it is a lower bound of path cost */
+	static FVector::FReal GetMinAreaCost(const FSharedConstNavQueryFilter& Filter)
+	{
+#if WITH_RECAST
+		if (Filter.IsValid())
+		{
+			float AreaCosts[RECAST_MAX_AREAS];
+			float FixedAreaCosts[RECAST_MAX_AREAS];
+			Filter->GetAllAreaCosts(AreaCosts, FixedAreaCosts, RECAST_MAX_AREAS);
+
+			float MinAreaCost = AreaCosts[0];
+			for (int32 AreaIndex = 1; AreaIndex < RECAST_MAX_AREAS; AreaIndex++)
+			{
+				MinAreaCost = FMath::Min(MinAreaCost, AreaCosts[AreaIndex]);
+			}
+			return FMath::Max(0.f, MinAreaCost);
+		}
+#endif
+		return 1.0;
+	}
+
+	/** @return last point between FirstIndex and LastIndex whose corridor up to it still exists on NavData, INDEX_NONE if none
+	 *  Rebuilt tiles get new poly refs, so a segment can pass raycasts while the polys the path kept for it are gone
+	 */
+	static int32 GetLastValidCorridorIndex(const ANavigationData& NavData, const FNavigationPath& InPath, int32 FirstIndex, int32 LastIndex)
+	{
+#if WITH_RECAST
+		const FNavMeshPath* MeshPath = InPath.CastPath<FNavMeshPath>();
+		if (MeshPath == nullptr)
+		{
+			return LastIndex;
+		}
+
+		const TArray<FNavPathPoint>& PathPoints = InPath.GetPathPoints();
+		const TArray<NavNodeRef>& Corridor = MeshPath->PathCorridor;
+		int32 CorridorIndex = FMath::Max(0, Corridor.IndexOfByKey(PathPoints[FirstIndex].NodeRef));
+		int32 LastValidIndex = INDEX_NONE;
+		for (int32 Index = FirstIndex; Index <= LastIndex; Index++)
+		{
+			for (; CorridorIndex < Corridor.Num() && Corridor[CorridorIndex] != PathPoints[Index].NodeRef; CorridorIndex++)
+			{
+				if (!NavData.IsNodeRefValid(Corridor[CorridorIndex]))
+				{
+					return LastValidIndex;
+				}
+			}
+
+			if (!NavData.IsNodeRefValid(PathPoints[Index].NodeRef))
+			{
+				return LastValidIndex;
+			}
+			LastValidIndex = Index;
+		}
+		return LastValidIndex;
+#else
+		return LastIndex;
+#endif
+	}
+}
+
+FPlayerMoveToDriver::FPlayerMoveToDriver()
+	: OwnerTask(nullptr)
+{
+	MoveRequestID = FAIRequestID::InvalidRequest;
+	AsyncPathQueryID = INVALID_NAVQUERYID;
+	PredictedMoveId = 0;
+	ReplicatedMoveId = 0;
+	ReplicatedPathStartIndex = 0;
+
+	MoveRequest.SetAcceptanceRadius(GET_AI_CONFIG_VAR(AcceptanceRadius));
+	MoveRequest.SetReachTestIncludesAgentRadius(GET_AI_CONFIG_VAR(bFinishMoveOnGoalOverlap));
+	MoveRequest.SetAllowPartialPath(GET_AI_CONFIG_VAR(bAcceptPartialPaths));
+	MoveRequest.SetUsePathfinding(true);
+
+	MoveResult = EPathFollowingResult::Invalid;
+	bUseContinuousTracking = false;
+	bUseAsyncPathfinding = false;
+	bAsyncPathQueryOnWorker = false;
+	bCountedAsActive = false;
+	bTelemetryRecorded = false;
+	bHoldingAtGoal = false;
+	bUseHierarchicalPathfinding = false;
+	bUseStreamingGoal = false;
+	bOnFinalLeg = true;
+	bHoldingAtRouteEnd = false;
+	bUseClientPrediction = false;
+	bReplicatePath = false;
+	bPendingRetarget = false;
+	bPendingRetargetKeepsRequest = false;
+	bPendingRetargetReusesPrefix = false;
+	bPredictionReportPending = false;
+	NumPathExtensions = 0;
+	RouteWaypointIndex = 0;
+	LastGoalRepathTime = -UE_BIG_NUMBER;
+	LastPredictionReportTime = -UE_BIG_NUMBER;
+	ObservedGoalLocation = FAISystem::InvalidLocation;
+	ActivationRealTime = 0.0;
+	ActivationGameTime = 0.0;
+}
+
+SIZE_T FPlayerMoveToDriver::GetAllocatedSize() const
+{
+	return ReplicatedPathPoints.GetAllocatedSize() + RouteWaypoints.GetAllocatedSize();
+}
+
+SIZE_T FPlayerMoveToDriver::GetPathAllocatedSize(const FNavigationPath& InPath)
+{
+#if WITH_RECAST
+	if (const FNavMeshPath* MeshPath = InPath.CastPath<FNavMeshPath>())
+	{
+		return sizeof(FNavMeshPath) + MeshPath->GetPathPoints().GetAllocatedSize() + MeshPath->PathCorridor.GetAllocatedSize()
+			+ MeshPath->PathCorridorCost.GetAllocatedSize() + MeshPath->CustomLinkIds.GetAllocatedSize();
+	}
+#endif
+	return sizeof(FNavigationPath) + InPath.GetPathPoints().GetAllocatedSize();
+}
+
+void FPlayerMoveToDriver::Initialize(UGameplayTask& InOwnerTask)
+{
+	OwnerTask = &InOwnerTask;
+}
+
+void FPlayerMoveToDriver::SetUp(APlayerController* Controller, const FAIMoveRequest& InMoveRequest)
+{
+	OwnerController = Controller;
+	MoveRequest = InMoveRequest;
+}
+
+UPathFollowingComponent* FPlayerMoveToDriver::InitNavigationControl(AController& Controller)
+{
+	const AAIController* AsAIController = Cast<AAIController>(&Controller);
+	const IPlayerMoveToPathFollowingProvider* Provider = Cast<IPlayerMoveToPathFollowingProvider>(&Controller);
+	UPathFollowingComponent* PathFollowingComp = nullptr;
+
+	if (AsAIController)
+	{
+		PathFollowingComp = AsAIController->GetPathFollowingComponent();
+	}
+	else if (Provider)
+	{
+		PathFollowingComp = Provider->GetPlayerPathFollowingComponent();
+	}
+
+	if (PathFollowingComp == nullptr && AsAIController == nullptr)
+	{
+		PathFollowingComp = Controller.FindComponentByClass<UPathFollowingComponent>();
+		if (PathFollowingComp == nullptr)
+		{
+			PathFollowingComp = NewObject<UPathFollowingComponent>(&Controller);
+			PathFollowingComp->RegisterComponentWithWorld(Controller.GetWorld());
+			PathFollowingComp->Initialize();
+		}
+	}
+
+	return PathFollowingComp;
+}
+
+UWorld* FPlayerMoveToDriver::GetWorld() const
+{
+	return OwnerTask ? OwnerTask->GetWorld() : nullptr;
+}
+
+UGameplayTasksComponent* FPlayerMoveToDriver::GetGameplayTasksComponent() const
+{
+	return OwnerTask ? OwnerTask->GetGameplayTasksComponent() : nullptr;
+}
+
+FString FPlayerMoveToDriver::GetName() const
+{
+	return GetNameSafe(OwnerTask);
+}
+
+void FPlayerMoveToDriver::FinishMoveTask(EPathFollowingResult::Type InResult)
+{
+	if (MoveRequestID.IsValid())
+	{
+		if (PathFollowingComp && PathFollowingComp->GetStatus() != EPathFollowingStatus::Idle)
+		{
+			ResetObservers();
+			PathFollowingComp->AbortMove(*OwnerTask, FPathFollowingResultFlags::OwnerFinished, MoveRequestID);
+		}
+	}
+
+	MoveResult = InResult;
+	RecordTelemetry(InResult);
+	OnMoveFinished.ExecuteIfBound(InResult);
+}
+
+void FPlayerMoveToDriver::Activate()
+{
+	if (!bCountedAsActive)
+	{
+		bCountedAsActive = true;
+		INC_DWORD_STAT(STAT_PlayerMoveTo_ActiveTasks);
+		TRACE_COUNTER_INCREMENT(PlayerMoveTo_ActiveTasks);
+
+		Telemetry = FPlayerMoveTelemetry();
+		bTelemetryRecorded = false;
+		ActivationRealTime = FPlatformTime::Seconds();
+		ActivationGameTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+		RouteWaypointIndex = 0;
+	}
+
+	if (OwnerController)
+	{
+		PathFollowingComp = InitNavigationControl(*OwnerController);
+
+		PLAYERMOVETO_CVLOG(bUseContinuousTracking, GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("Continuous goal tracking requested, moving to: %s"),
+			MoveRequest.IsMoveToActorRequest() ? TEXT("actor => looping successful moves!") : TEXT("location => will NOT loop"));
+
+		MoveRequestID = FAIRequestID::InvalidRequest;
+		ConditionalPerformMove();
+	}
+}
+
+FAIMoveRequest FPlayerMoveToDriver::MakeMoveRequest(const FAIMoveRequest& Settings, const FVector& GoalLocation, AActor* GoalActor)
+{
+	FAIMoveRequest Request;
+	if (GoalActor)
+	{
+		Request.SetGoalActor(GoalActor);
+	}
+	else
+	{
+		Request.SetGoalLocation(GoalLocation);
+	}
+
+	Request.SetNavigationFilter(Settings.GetNavigationFilter());
+	Request.SetAcceptanceRadius(Settings.GetAcceptanceRadius());
+	Request.SetReachTestIncludesAgentRadius(Settings.IsReachTestIncludingAgentRadius());
+	Request.SetReachTestIncludesGoalRadius(Settings.IsReachTestIncludingGoalRadius());
+	Request.SetAllowPartialPath(Settings.IsUsingPartialPaths());
+	Request.SetUsePathfinding(Settings.IsUsingPathfinding());
+	Request.SetProjectGoalLocation(Settings.IsProjectingGoal());
+	Request.SetCanStrafe(Settings.CanStrafe());
+	Request.SetUserData(Settings.GetUserData());
+	Request.SetUserFlags(Settings.GetUserFlags());
+	return Request;
+}
+
+void FPlayerMoveToDriver::Retarget(const FVector& GoalLocation, AActor* GoalActor, bool bReusePathPrefix)
+{
+	// goal of an initialized request can't be set again, only location goals can be updated
+	const bool bWasMoveToActor = MoveRequest.IsMoveToActorRequest();
+	if (GoalActor || bWasMoveToActor)
+	{
+		MoveRequest = MakeMoveRequest(MoveRequest, GoalLocation, GoalActor);
+	}
+	else
+	{
+		MoveRequest.UpdateGoalLocation(GoalLocation);
+	}
+
+	// route led to the previous goal
+	RouteWaypoints.Reset();
+	RouteWaypointIndex = 0;
+
+	// not started yet, new goal is picked up on activation
+	if (!bCountedAsActive)
+	{
+		return;
+	}
+
+	const bool bKeepRequest = !GoalActor && !bWasMoveToActor;
+
+	// paused move must not start moving, new goal is picked up on resume
+	if (OwnerTask && OwnerTask->IsPaused())
+	{
+		bPendingRetargetKeepsRequest = bPendingRetarget ? bPendingRetargetKeepsRequest && bKeepRequest : bKeepRequest;
+		bPendingRetargetReusesPrefix = bReusePathPrefix;
+		bPendingRetarget = true;
+		return;
+	}
+
+	ApplyRetarget(bKeepRequest, bReusePathPrefix);
+}
+
+void FPlayerMoveToDriver::ApplyRetarget(bool bKeepRequest, bool bReusePathPrefix)
+{
+	PLAYERMOVETO_VLOG_LOCATION(GetGameplayTasksComponent(), LogGameplayTasks, Log, GetMoveGoalLocation(MoveRequest), 30.f, FColor::Cyan, TEXT("%s> retargeting move"), *GetName());
+
+	if (bKeepRequest && !IsFollowingRoute() && RetargetFollowedPath(bReusePathPrefix))
+	{
+		return;
+	}
+
+	// path following request can't be kept, goal actor of a request can't be changed either,
+	// start over without recreating the task
+	ConditionalPerformMove();
+}
+
+bool FPlayerMoveToDriver::RetargetFollowedPath(bool bReusePathPrefix)
+{
+	PLAYERMOVETO_SCOPE(Repath);
+
+	// async searches deliver a new path through RequestMoveOnPath, only sync ones can swap it in place
+	if (!IsFollowingObservedPath() || IsWaitingForPath() || !MoveRequest.IsUsingPathfinding()
+		|| PlayerMoveToDriver::GetPathfindingMode(bUseAsyncPathfinding) != PlayerMoveToDriver::EPathfindingMode::Sync
+		|| (OwnerController && OwnerController->ShouldPostponePathUpdates()))
+	{
+		return false;
+	}
+
+	if (MoveRequest.IsProjectingGoal())
+	{
+		const ANavigationData* NavData = Path->GetNavigationDataUsed();
+		FNavLocation ProjectedLocation;
+		if (NavData == nullptr || !ProjectGoal(*NavData, MoveRequest.GetGoalLocation(), ProjectedLocation))
+		{
+			return false;
+		}
+		MoveRequest.UpdateGoalLocation(ProjectedLocation.Location);
+	}
+
+	FPathFindingQuery Query;
+	if (!BuildPathfindingQuery(MoveRequest, Query))
+	{
+		return false;
+	}
+
+	// keep walking towards the point pawn is heading to, so it doesn't turn around mid segment
+	TArray<FNavPathPoint> NewPoints;
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	const int32 NextIndex = PathFollowingComp->GetCurrentPathIndex() + 1;
+	if (bReusePathPrefix && PathPoints.IsValidIndex(NextIndex) && NextIndex < PathPoints.Num() - 1)
+	{
+		NewPoints.Add(FNavPathPoint(Query.StartLocation));
+		Query.StartLocation = PathPoints[NextIndex].Location;
+	}
+
+	FNavPathSharedPtr NewPath;
+	FindPathForMoveRequest(MoveRequest, Query, NewPath);
+	if (!NewPath.IsValid() || NewPath->GetPathPoints().Num() < 2 || (NewPath->IsPartial() && !MoveRequest.IsUsingPartialPaths()))
+	{
+		return false;
+	}
+
+	NewPoints.Append(NewPath->GetPathPoints());
+	bHoldingAtGoal = false;
+	NumPathExtensions = 0;
+	UpdatePathInPlace(MoveTemp(NewPoints), NewPath.Get(), ENavPathUpdateType::GoalMoved);
+	return true;
+}
+
+void FPlayerMoveToDriver::ConditionalPerformMove()
+{
+	if (MoveRequest.IsUsingPathfinding() && OwnerController && OwnerController->ShouldPostponePathUpdates())
+	{
+		PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> can't path right now, waiting..."), *GetName());
+		INC_DWORD_STAT(STAT_PlayerMoveTo_MoveRetries);
+		Telemetry.NumRetries++;
+		TRACE_COUNTER_INCREMENT(PlayerMoveTo_Retries);
+		if (!MoveRetryHandle.IsValid())
+		{
+			MoveRetryHandle = WaitForNavigation([this]()
+			{
+				MoveRetryHandle.Reset();
+				ConditionalPerformMove();
+			});
+		}
+	}
+	else
+	{
+		StopWaitingForNavigation(MoveRetryHandle);
+		PerformMove();
+	}
+}
+
+void FPlayerMoveToDriver::PerformMove()
+{
+	PLAYERMOVETO_SCOPE(PerformMove);
+
+	if (PathFollowingComp == nullptr)
+	{
+		FinishMoveTask(EPathFollowingResult::Invalid);
+		return;
+	}
+
+	ResetObservers();
+	ResetTimers();
+	AbortAsyncPathRequest();
+
+	bHoldingAtGoal = false;
+	bHoldingAtRouteEnd = false;
+	NumPathExtensions = 0;
+
+	// start new move request
+	FNavPathSharedPtr FollowedPath;
+	const FPathFollowingRequestResult ResultData = MoveTo(MoveRequest, &FollowedPath);
+
+	switch (ResultData.Code)
+	{
+	case EPathFollowingRequestResult::Failed:
+		FinishMoveTask(EPathFollowingResult::Invalid);
+		break;
+
+	case EPathFollowingRequestResult::AlreadyAtGoal:
+		MoveRequestID = ResultData.MoveId;
+		OnRequestFinished(ResultData.MoveId, FPathFollowingResult(EPathFollowingResult::Success, FPathFollowingResultFlags::AlreadyAtGoal));
+		break;
+
+	case EPathFollowingRequestResult::RequestSuccessful:
+		StartGoalTracking();
+		StartRouteUpdates();
+
+		if (IsWaitingForPath())
+		{
+			// move will be requested from OnAsyncPathFound
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> waiting for async path query"), *GetName());
+			break;
+		}
+
+		MoveRequestID = ResultData.MoveId;
+		PathFinishDelegateHandle = PathFollowingComp->OnRequestFinished.AddWeakLambda(OwnerTask,
+			[this](FAIRequestID FinishedRequestID, const FPathFollowingResult& FinishedResult) { OnRequestFinished(FinishedRequestID, FinishedResult); });
+		SetObservedPath(FollowedPath);
+
+		if (OwnerTask->IsFinished())
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Error, TEXT("%s> re-Activating Finished task!"), *GetName());
+		}
+		break;
+
+	default:
+		checkNoEntry();
+		break;
+	}
+}
+
+FPathFollowingRequestResult FPlayerMoveToDriver::MoveTo(const FAIMoveRequest& InMoveRequest, FNavPathSharedPtr* OutPath)
+{
+	FPathFollowingRequestResult ResultData;
+	ResultData.Code = EPathFollowingRequestResult::Failed;
+
+	if (InMoveRequest.IsValid() == false)
+	{
+		PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Error, TEXT("MoveTo request failed due MoveRequest not being valid. Most probably desired Goal Actor not longer exists. MoveRequest: '%s'"), *MoveRequest.ToString());
+		return ResultData;
+	}
+
+	if (PathFollowingComp == nullptr)
+	{
+		PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Error, TEXT("MoveTo request failed due missing PathFollowingComponent"));
+		return ResultData;
+	}
+
+	// Actually, it works fine without one
+	// ensure(InMoveRequest.GetNavigationFilter());
+
+	bool bCanRequestMove = true;
+	bool bAlreadyAtGoal;
+
+	if (!InMoveRequest.IsMoveToActorRequest())
+	{
+		if (InMoveRequest.GetGoalLocation().ContainsNaN() || FAISystem::IsValidLocation(InMoveRequest.GetGoalLocation()) == false)
+		{
+			PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Error, TEXT("FPlayerMoveToDriver::MoveTo: Destination is not valid! Goal(%s)"), TEXT_AI_LOCATION(InMoveRequest.GetGoalLocation()));
+			bCanRequestMove = false;
+		}
+
+		// fail if projection to navigation is required but it failed
+		if (bCanRequestMove && InMoveRequest.IsProjectingGoal())
+		{
+			PLAYERMOVETO_SCOPE(GoalProjection);
+
+			UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+			const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(OwnerController->GetNavAgentPropertiesRef(), OwnerController->GetNavAgentLocation()) : nullptr;
+			FNavLocation ProjectedLocation;
+
+			if (NavData && ProjectGoal(*NavData, InMoveRequest.GetGoalLocation(), ProjectedLocation))
+			{
+				InMoveRequest.UpdateGoalLocation(ProjectedLocation.Location);
+			}
+			else if (NavSys && bUseStreamingGoal && InMoveRequest.IsUsingPathfinding())
+			{
+				// route heads to the closest loaded navigation until goal's navigation streams in
+				PLAYERMOVETO_VLOG_LOCATION(OwnerTask, LogGameplayTasks, Log, InMoveRequest.GetGoalLocation(), 30.f, FColor::Orange, TEXT("FPlayerMoveToDriver::MoveTo destination isn't on loaded navigation, moving towards it"));
+			}
+			else if (NavSys)
+			{
+				if (InMoveRequest.IsUsingPathfinding())
+				{
+					PLAYERMOVETO_VLOG_LOCATION(OwnerTask, LogGameplayTasks, Error, InMoveRequest.GetGoalLocation(), 30.f, FColor::Red, TEXT("FPlayerMoveToDriver::MoveTo failed to project destination location to navmesh"));
+				}
+				else
+				{
+					PLAYERMOVETO_VLOG_LOCATION(OwnerTask, LogGameplayTasks, Error, InMoveRequest.GetGoalLocation(), 30.f, FColor::Red, TEXT("FPlayerMoveToDriver::MoveTo failed to project destination location to navmesh, path finding is disabled perhaps disable goal projection ?"));
+				}
+
+				bCanRequestMove = false;
+			}
+		}
+
+		bAlreadyAtGoal = bCanRequestMove && PathFollowingComp->HasReached(InMoveRequest);
+	}
+	else
+	{
+		bAlreadyAtGoal = bCanRequestMove && PathFollowingComp->HasReached(InMoveRequest);
+	}
+
+	if (bAlreadyAtGoal)
+	{
+		PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Log, TEXT("MoveTo: already at goal!"));
+		ResultData.MoveId = PathFollowingComp->RequestMoveWithImmediateFinish(EPathFollowingResult::Success);
+		ResultData.Code = EPathFollowingRequestResult::AlreadyAtGoal;
+	}
+	else if (bCanRequestMove)
+	{
+		FPathFindingQuery PFQuery;
+
+		const bool bValidQuery = BuildPathfindingQuery(InMoveRequest, PFQuery);
+		FNavPathSharedPtr NewPath = ConsumePrecomputedPath(InMoveRequest);
+
+		bOnFinalLeg = true;
+		if (bValidQuery && !NewPath.IsValid())
+		{
+			ApplyRouteLeg(PFQuery);
+		}
+		const PlayerMoveToDriver::EPathfindingMode PathfindingMode = PlayerMoveToDriver::GetPathfindingMode(bUseAsyncPathfinding);
+		if (bValidQuery && !NewPath.IsValid() && PathfindingMode != PlayerMoveToDriver::EPathfindingMode::Sync && InMoveRequest.IsUsingPathfinding() && !FindCachedPath(InMoveRequest, PFQuery, NewPath))
+		{
+			if (FindPathAsyncForMoveRequest(InMoveRequest, PFQuery, PathfindingMode == PlayerMoveToDriver::EPathfindingMode::Worker))
+			{
+				// path following request will be made once the query completes
+				ResultData.Code = EPathFollowingRequestResult::RequestSuccessful;
+				return ResultData;
+			}
+		}
+		else if (bValidQuery)
+		{
+			if (!NewPath.IsValid())
+			{
+				FindPathForMoveRequest(InMoveRequest, PFQuery, NewPath);
+			}
+			SmoothFoundPath(NewPath);
+
+			PLAYERMOVETO_SCOPE(RequestMove);
+			const FAIRequestID RequestID = PathFollowingComp && NewPath.IsValid() ? PathFollowingComp->RequestMove(InMoveRequest, NewPath) : FAIRequestID::InvalidRequest;
+			if (RequestID.IsValid())
+			{
+				// bAllowStrafe = InMoveRequest.CanStrafe();
+				ResultData.MoveId = RequestID;
+				ResultData.Code = EPathFollowingRequestResult::RequestSuccessful;
+
+				if (OutPath)
+				{
+					*OutPath = NewPath;
+				}
+			}
+		}
+	}
+
+	if (ResultData.Code == EPathFollowingRequestResult::Failed)
+	{
+		ResultData.MoveId = PathFollowingComp->RequestMoveWithImmediateFinish(EPathFollowingResult::Invalid);
+	}
+
+	return ResultData;
+}
+
+bool FPlayerMoveToDriver::BuildPathfindingQuery(const APlayerController& Controller, const FAIMoveRequest& InMoveRequest, const UObject* Querier, FPathFindingQuery& Query)
+{
+	PLAYERMOVETO_SCOPE(QueryBuilding);
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(Controller.GetWorld());
+	const ANavigationData* NavData = (NavSys == nullptr) ? nullptr :
+		InMoveRequest.IsUsingPathfinding() ? NavSys->GetNavDataForProps(Controller.GetNavAgentPropertiesRef(), Controller.GetNavAgentLocation()) :
+		NavSys->GetAbstractNavData();
+
+	if (NavData == nullptr)
+	{
+		return false;
+	}
+
+	const FVector GoalLocation = GetMoveGoalLocation(Controller, InMoveRequest);
+	const FSharedConstNavQueryFilter NavFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, Querier, InMoveRequest.GetNavigationFilter());
+	Query = FPathFindingQuery(&Controller, *NavData, Controller.GetNavAgentLocation(), GoalLocation, NavFilter);
+	Query.SetAllowPartialPaths(InMoveRequest.IsUsingPartialPaths());
+	return true;
+}
+
+bool FPlayerMoveToDriver::BuildPathfindingQuery(const FAIMoveRequest& InMoveRequest, FPathFindingQuery& Query) const
+{
+	const bool bResult = BuildPathfindingQuery(*OwnerController, InMoveRequest, OwnerTask, Query);
+	if (bResult)
+	{
+		if (PathFollowingComp)
+		{
+			PathFollowingComp->OnPathfindingQuery(Query);
+		}
+	}
+	else
+	{
+		if (FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()) == nullptr)
+		{
+			PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Warning, TEXT("Unable FPlayerMoveToDriver::BuildPathfindingQuery due to no NavigationSystem present. Note that even pathfinding-less movement requires presence of NavigationSystem."));
+		}
+		else
+		{
+			PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Warning, TEXT("Unable to find NavigationData instance while calling FPlayerMoveToDriver::BuildPathfindingQuery"));
+		}
+	}
+
+	return bResult;
+}
+
+FVector FPlayerMoveToDriver::GetMoveGoalLocation(const FAIMoveRequest& InMoveRequest) const
+{
+	return GetMoveGoalLocation(*OwnerController, InMoveRequest);
+}
+
+FVector FPlayerMoveToDriver::GetMoveGoalLocation(const APlayerController& Controller, const FAIMoveRequest& InMoveRequest)
+{
+	FVector GoalLocation = InMoveRequest.GetGoalLocation();
+	if (InMoveRequest.IsMoveToActorRequest())
+	{
+		const INavAgentInterface* NavGoal = Cast<const INavAgentInterface>(InMoveRequest.GetGoalActor());
+		if (NavGoal)
+		{
+			const FVector Offset = NavGoal->GetMoveGoalOffset(Controller.GetPawn());
+			GoalLocation = FQuatRotationTranslationMatrix(InMoveRequest.GetGoalActor()->GetActorQuat(), NavGoal->GetNavAgentLocation()).TransformPosition(Offset);
+		}
+		else
+		{
+			GoalLocation = InMoveRequest.GetGoalActor()->GetActorLocation();
+		}
+	}
+	return GoalLocation;
+}
+
+void FPlayerMoveToDriver::FindPathForMoveRequest(const FAIMoveRequest& InMoveRequest, FPathFindingQuery& Query,
+	FNavPathSharedPtr& OutPath) const
+{
+	if (FindCachedPath(InMoveRequest, Query, OutPath))
+	{
+		return;
+	}
+
+	PLAYERMOVETO_SCOPE(PathSearch);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys)
+	{
+		const FPathFindingResult PathResult = NavSys->FindPathSync(Query);
+		if (PathResult.Result != ENavigationQueryResult::Error)
+		{
+			if (PathResult.IsSuccessful() && PathResult.Path.IsValid())
+			{
+				if (UPlayerMoveToCacheSubsystem* PathCache = UPlayerMoveToCacheSubsystem::Get(GetWorld()))
+				{
+					PathCache->AddPath(FPlayerMovePathCacheKey(Query, OwnerController->GetNavAgentPropertiesRef(), InMoveRequest.GetNavigationFilter()), PathResult.Path);
+				}
+
+				PrepareFoundPath(InMoveRequest, PathResult.Path);
+				OutPath = PathResult.Path;
+			}
+		}
+		else
+		{
+			PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Error, TEXT("Trying to find path to %s resulted in Error")
+				, InMoveRequest.IsMoveToActorRequest() ? *GetNameSafe(InMoveRequest.GetGoalActor()) : *InMoveRequest.GetGoalLocation().ToString());
+			PLAYERMOVETO_VLOG_SEGMENT(OwnerTask, LogGameplayTasks, Error, OwnerController->GetPawn() ? OwnerController->GetPawn()->GetActorLocation() : FAISystem::InvalidLocation
+				, InMoveRequest.GetGoalLocation(), FColor::Red, TEXT("Failed move to %s"), *GetNameSafe(InMoveRequest.GetGoalActor()));
+		}
+	}
+}
+
+bool FPlayerMoveToDriver::FindCachedPath(const FAIMoveRequest& InMoveRequest, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+	PLAYERMOVETO_SCOPE(PathCacheLookup);
+
+	UPlayerMoveToCacheSubsystem* PathCache = InMoveRequest.IsUsingPathfinding() ? UPlayerMoveToCacheSubsystem::Get(GetWorld()) : nullptr;
+	if (PathCache == nullptr)
+	{
+		return false;
+	}
+
+	FNavPathSharedPtr CachedPath = PathCache->FindPath(FPlayerMovePathCacheKey(Query, OwnerController->GetNavAgentPropertiesRef(), InMoveRequest.GetNavigationFilter()), Query);
+	if (!CachedPath.IsValid())
+	{
+		return false;
+	}
+
+	PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Log, TEXT("Using cached path to %s")
+		, InMoveRequest.IsMoveToActorRequest() ? *GetNameSafe(InMoveRequest.GetGoalActor()) : *InMoveRequest.GetGoalLocation().ToString());
+
+	PrepareFoundPath(InMoveRequest, CachedPath);
+	OutPath = CachedPath;
+	return true;
+}
+
+void FPlayerMoveToDriver::PrepareFoundPath(const FAIMoveRequest& InMoveRequest, const FNavPathSharedPtr& InPath) const
+{
+	// goal actor is set so repaths head towards its current location, but the path is never repathed by navigation data's
+	// own observation: UpdateGoalTracking repaths it according to GoalObservation, goal tracking retargets it instead
+	if (InMoveRequest.IsMoveToActorRequest() && InMoveRequest.GetGoalActor() && !IsTrackingGoal())
+	{
+		InPath->SetGoalActorObservation(*InMoveRequest.GetGoalActor(), WORLD_MAX);
+	}
+
+	InPath->EnableRecalculationOnInvalidation(true);
+}
+
+void FPlayerMoveToDriver::SmoothFoundPath(const FNavPathSharedPtr& InPath) const
+{
+	const ANavigationData* NavData = InPath.IsValid() ? InPath->GetNavigationDataUsed() : nullptr;
+	if (NavData && PlayerMoveToPathSmoothing::IsEnabled())
+	{
+		PlayerMoveToPathSmoothing::SmoothPath(*InPath, *NavData, OwnerTask);
+	}
+}
+
+FNavPathSharedPtr FPlayerMoveToDriver::ConsumePrecomputedPath(const FAIMoveRequest& InMoveRequest)
+{
+	FNavPathSharedPtr NewPath = MoveTemp(PrecomputedPath);
+	PrecomputedPath.Reset();
+
+	// navmesh could have been rebuilt under it, or pawn moved away from its start, if activation was delayed
+	const bool bStartValid = NewPath.IsValid() && NewPath->GetPathPoints().Num() > 0 && OwnerController &&
+		FVector::DistSquared2D(NewPath->GetPathPoints()[0].Location, OwnerController->GetNavAgentLocation()) <= FMath::Square(PlayerMoveToCVars::BatchStartTolerance);
+	if (bStartValid && NewPath->IsValid())
+	{
+		PrepareFoundPath(InMoveRequest, NewPath);
+		return NewPath;
+	}
+	return nullptr;
+}
+
+FVector FPlayerMoveToDriver::GetGoalProjectionExtent(const ANavigationData& NavData)
+{
+	const FVector DefaultExtent = NavData.GetDefaultQueryExtent();
+	return FVector(
+		PlayerMoveToCVars::GoalProjectionHorizontalExtent > 0.f ? PlayerMoveToCVars::GoalProjectionHorizontalExtent : DefaultExtent.X,
+		PlayerMoveToCVars::GoalProjectionHorizontalExtent > 0.f ? PlayerMoveToCVars::GoalProjectionHorizontalExtent : DefaultExtent.Y,
+		PlayerMoveToCVars::GoalProjectionVerticalExtent > 0.f ? PlayerMoveToCVars::GoalProjectionVerticalExtent : DefaultExtent.Z);
+}
+
+bool FPlayerMoveToDriver::ProjectGoal(const ANavigationData& NavData, const FVector& Goal, FNavLocation& OutLocation)
+{
+	PLAYERMOVETO_SCOPE(GoalProjection);
+
+	UPlayerMoveToCacheSubsystem* ProjectionCache = UPlayerMoveToCacheSubsystem::Get(NavData.GetWorld());
+	if (ProjectionCache && ProjectionCache->FindProjection(&NavData, Goal, OutLocation))
+	{
+		return true;
+	}
+
+	if (!NavData.ProjectPoint(Goal, OutLocation, GetGoalProjectionExtent(NavData)))
+	{
+		return false;
+	}
+
+	if (ProjectionCache)
+	{
+		ProjectionCache->AddProjection(&NavData, Goal, OutLocation);
+	}
+	return true;
+}
+
+void FPlayerMoveToDriver::ProjectGoals(const ANavigationData& NavData, TArray<FNavigationProjectionWork>& Workload)
+{
+	PLAYERMOVETO_SCOPE(GoalProjection);
+
+	// cached goals are done, the rest is projected in one batch
+	UPlayerMoveToCacheSubsystem* ProjectionCache = UPlayerMoveToCacheSubsystem::Get(NavData.GetWorld());
+	TArray<int32> MissIndices;
+	TArray<FNavigationProjectionWork> MissWorkload;
+	for (int32 WorkIndex = 0; WorkIndex < Workload.Num(); WorkIndex++)
+	{
+		FNavigationProjectionWork& Work = Workload[WorkIndex];
+		Work.bResult = ProjectionCache && ProjectionCache->FindProjection(&NavData, Work.Point, Work.OutLocation);
+		if (!Work.bResult)
+		{
+			MissIndices.Add(WorkIndex);
+			MissWorkload.Emplace(Work.Point, Work.ProjectionLimit);
+		}
+	}
+
+	if (MissWorkload.Num() == 0)
+	{
+		return;
+	}
+
+	NavData.BatchProjectPoints(MissWorkload, GetGoalProjectionExtent(NavData));
+
+	for (int32 MissIndex = 0; MissIndex < MissWorkload.Num(); MissIndex++)
+	{
+		FNavigationProjectionWork& Work = Workload[MissIndices[MissIndex]];
+		Work.bResult = MissWorkload[MissIndex].bResult;
+		Work.OutLocation = MissWorkload[MissIndex].OutLocation;
+		if (Work.bResult && ProjectionCache)
+		{
+			ProjectionCache->AddProjection(&NavData, Work.Point, Work.OutLocation);
+		}
+	}
+}
+
+void FPlayerMoveToDriver::FindPathsBatch(TArrayView<FPlayerMoveToDriver* const> Drivers)
+{
+	PLAYERMOVETO_SCOPE(BatchPathSearch);
+
+	UWorld* World = Drivers.Num() > 0 && Drivers[0] ? Drivers[0]->GetWorld() : nullptr;
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (NavSys == nullptr)
+	{
+		return;
+	}
+
+	// project goal locations, one batch per navigation data
+	TMap<const ANavigationData*, TArray<int32>> ProjectionBatches;
+	for (int32 Index = 0; Index < Drivers.Num(); Index++)
+	{
+		const FPlayerMoveToDriver* Driver = Drivers[Index];
+		if (Driver && Driver->OwnerController && Driver->MoveRequest.IsValid() && !Driver->MoveRequest.IsMoveToActorRequest() && Driver->MoveRequest.IsProjectingGoal())
+		{
+			const ANavigationData* NavData = NavSys->GetNavDataForProps(Driver->OwnerController->GetNavAgentPropertiesRef(), Driver->OwnerController->GetNavAgentLocation());
+			if (NavData)
+			{
+				ProjectionBatches.FindOrAdd(NavData).Add(Index);
+			}
+		}
+	}
+
+	for (const TPair<const ANavigationData*, TArray<int32>>& Batch : ProjectionBatches)
+	{
+		TArray<FNavigationProjectionWork> Workload;
+		Workload.Reserve(Batch.Value.Num());
+		for (const int32 Index : Batch.Value)
+		{
+			Workload.Emplace(Drivers[Index]->MoveRequest.GetGoalLocation());
+		}
+
+		ProjectGoals(*Batch.Key, Workload);
+
+		for (int32 WorkIndex = 0; WorkIndex < Workload.Num(); WorkIndex++)
+		{
+			// failed projections are left to MoveTo, so they are reported the same way as a single request
+			if (Workload[WorkIndex].bResult)
+			{
+				FAIMoveRequest& Request = Drivers[Batch.Value[WorkIndex]]->MoveRequest;
+				Request.UpdateGoalLocation(Workload[WorkIndex].OutLocation.Location);
+				Request.SetProjectGoalLocation(false);
+			}
+		}
+	}
+
+	// build queries on game thread, served from path cache when possible
+	UPlayerMoveToCacheSubsystem* PathCache = UPlayerMoveToCacheSubsystem::Get(World);
+	TArray<int32> QueryOwners;
+	TArray<FPathFindingQuery> Queries;
+	for (int32 Index = 0; Index < Drivers.Num(); Index++)
+	{
+		FPlayerMoveToDriver* Driver = Drivers[Index];
+		if (Driver == nullptr || Driver->OwnerController == nullptr || !Driver->MoveRequest.IsValid() ||
+			!Driver->MoveRequest.IsUsingPathfinding() || Driver->MoveRequest.IsProjectingGoal())
+		{
+			continue;
+		}
+
+		Driver->PathFollowingComp = InitNavigationControl(*Driver->OwnerController);
+
+		FPathFindingQuery Query;
+		if (!Driver->BuildPathfindingQuery(Driver->MoveRequest, Query) || !Query.NavData.IsValid())
+		{
+			continue;
+		}
+
+		FNavPathSharedPtr CachedPath;
+		if (Driver->FindCachedPath(Driver->MoveRequest, Query, CachedPath))
+		{
+			Driver->PrecomputedPath = CachedPath;
+			continue;
+		}
+
+		QueryOwners.Add(Index);
+		Queries.Add(Query);
+	}
+
+	TArray<const ANavigationData*> QueryNavData;
+	TArray<const ANavigationData*> LockedNavData;
+	QueryNavData.Reserve(Queries.Num());
+	for (const FPathFindingQuery& Query : Queries)
+	{
+		QueryNavData.Add(Query.NavData.Get());
+		LockedNavData.AddUnique(Query.NavData.Get());
+	}
+
+	// searches hold the batch query lock of their navigation data, same as the engine's batched queries,
+	// it is taken and released on game thread since its counter isn't thread safe
+	for (const ANavigationData* NavData : LockedNavData)
+	{
+		NavData->BeginBatchQuery();
+	}
+
+	TArray<FPathFindingResult> Results;
+	Results.SetNum(Queries.Num());
+	ParallelFor(Queries.Num(), [&Queries, &QueryNavData, &Results](int32 QueryIndex)
+	{
+		PLAYERMOVETO_SCOPE(PathSearch);
+		Results[QueryIndex] = QueryNavData[QueryIndex]->FindPath(Queries[QueryIndex].NavAgentProperties, Queries[QueryIndex]);
+	}, PlayerMoveToCVars::bParallelBatchPathfinding ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	for (const ANavigationData* NavData : LockedNavData)
+	{
+		NavData->FinishBatchQuery();
+	}
+
+	for (int32 QueryIndex = 0; QueryIndex < Results.Num(); QueryIndex++)
+	{
+		const FPathFindingResult& PathResult = Results[QueryIndex];
+		FPlayerMoveToDriver* Driver = Drivers[QueryOwners[QueryIndex]];
+		if (PathResult.IsSuccessful() && PathResult.Path.IsValid())
+		{
+			if (PathCache)
+			{
+				PathCache->AddPath(FPlayerMovePathCacheKey(Queries[QueryIndex], Driver->OwnerController->GetNavAgentPropertiesRef(), Driver->MoveRequest.GetNavigationFilter()), PathResult.Path);
+			}
+
+			Driver->PrecomputedPath = PathResult.Path;
+		}
+		// failed searches are repeated by MoveTo, which reports them the same way as a single request
+	}
+}
+
+int32 FPlayerMoveToDriver::SelectNearestGoal(const TArray<FVector>& GoalLocations, const TArray<AActor*>& GoalActors)
+{
+	PLAYERMOVETO_SCOPE(NearestGoalSelection);
+
+	if (OwnerController == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	struct FGoalCandidate
+	{
+		FVector Location;
+		AActor* Actor;
+		int32 Index;
+		FVector::FReal Distance;
+	};
+
+	const FVector AgentLocation = OwnerController->GetNavAgentLocation();
+	TArray<FGoalCandidate> Candidates;
+	Candidates.Reserve(GoalLocations.Num() + GoalActors.Num());
+	for (int32 Index = 0; Index < GoalLocations.Num(); Index++)
+	{
+		if (FAISystem::IsValidLocation(GoalLocations[Index]))
+		{
+			Candidates.Add({ GoalLocations[Index], nullptr, Index, FVector::Dist(AgentLocation, GoalLocations[Index]) });
+		}
+	}
+	for (int32 Index = 0; Index < GoalActors.Num(); Index++)
+	{
+		if (GoalActors[Index])
+		{
+			FAIMoveRequest ActorRequest(GoalActors[Index]);
+			const FVector Location = GetMoveGoalLocation(ActorRequest);
+			Candidates.Add({ Location, GoalActors[Index], GoalLocations.Num() + Index, FVector::Dist(AgentLocation, Location) });
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys && MoveRequest.IsUsingPathfinding() ? NavSys->GetNavDataForProps(OwnerController->GetNavAgentPropertiesRef(), AgentLocation) : nullptr;
+
+	// project all location goals at once, unreachable ones are dropped
+	if (NavData && MoveRequest.IsProjectingGoal())
+	{
+		TArray<int32> WorkOwners;
+		TArray<FNavigationProjectionWork> Workload;
+		for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+		{
+			if (Candidates[CandidateIndex].Actor == nullptr)
+			{
+				WorkOwners.Add(CandidateIndex);
+				Workload.Emplace(Candidates[CandidateIndex].Location);
+			}
+		}
+
+		ProjectGoals(*NavData, Workload);
+
+		for (int32 WorkIndex = Workload.Num() - 1; WorkIndex >= 0; WorkIndex--)
+		{
+			FGoalCandidate& Candidate = Candidates[WorkOwners[WorkIndex]];
+			if (Workload[WorkIndex].bResult)
+			{
+				Candidate.Location = Workload[WorkIndex].OutLocation.Location;
+				Candidate.Distance = FVector::Dist(AgentLocation, Candidate.Location);
+			}
+			else
+			{
+				Candidates.RemoveAt(WorkOwners[WorkIndex]);
+			}
+		}
+
+		if (Candidates.Num() == 0)
+		{
+			// goal is left as it is, MoveTo reports failed projection
+			return INDEX_NONE;
+		}
+	}
+
+	Candidates.Sort([](const FGoalCandidate& A, const FGoalCandidate& B) { return A.Distance < B.Distance; });
+
+	const FGoalCandidate* BestCandidate = nullptr;
+	FNavPathSharedPtr BestPath;
+	if (NavData)
+	{
+		PathFollowingComp = InitNavigationControl(*OwnerController);
+
+		// closest goals first, every search is limited by cost of the cheapest path so far and straight line
+		// distance times the cheapest area cost is a lower bound of path cost, so candidates that can't beat it end early
+		// or aren't searched at all
+		FVector::FReal BestCost = TNumericLimits<FVector::FReal>::Max();
+		for (const FGoalCandidate& Candidate : Candidates)
+		{
+			// move request is already initialized with the first goal, its goal can't be changed
+			const FAIMoveRequest CandidateRequest = MakeMoveRequest(MoveRequest, Candidate.Location, Candidate.Actor);
+
+			FPathFindingQuery Query;
+			if (!BuildPathfindingQuery(CandidateRequest, Query) || !Query.NavData.IsValid())
+			{
+				continue;
+			}
+
+			const FVector::FReal MinAreaCost = PlayerMoveToDriver::GetMinAreaCost(Query.QueryFilter);
+			if (BestPath.IsValid() && Candidate.Distance * MinAreaCost >= BestCost)
+			{
+				break;
+			}
+
+			FNavPathSharedPtr CandidatePath;
+			if (!FindCachedPath(CandidateRequest, Query, CandidatePath))
+			{
+				PLAYERMOVETO_SCOPE(PathSearch);
+
+				Query.SetAllowPartialPaths(false);
+
+				// search heuristic assumes area costs of at least 1, with cheaper areas the limit could cut the cheapest path
+				Query.CostLimit = MinAreaCost >= 1.0 ? BestCost : TNumericLimits<FVector::FReal>::Max();
+				const FPathFindingResult PathResult = Query.NavData->FindPath(Query.NavAgentProperties, Query);
+				if (!PathResult.IsSuccessful() || !PathResult.Path.IsValid() || PathResult.Path->IsPartial())
+				{
+					continue;
+				}
+
+				CandidatePath = PathResult.Path;
+				if (UPlayerMoveToCacheSubsystem* PathCache = UPlayerMoveToCacheSubsystem::Get(GetWorld()))
+				{
+					PathCache->AddPath(FPlayerMovePathCacheKey(Query, OwnerController->GetNavAgentPropertiesRef(), CandidateRequest.GetNavigationFilter()), CandidatePath);
+				}
+			}
+
+			const FVector::FReal Cost = CandidatePath->GetCost();
+			if (Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestPath = CandidatePath;
+				BestCandidate = &Candidate;
+			}
+		}
+	}
+
+	// no complete path to any of them, closest one is left to MoveTo which reports it the same way as a single request
+	if (BestCandidate == nullptr)
+	{
+		BestCandidate = &Candidates[0];
+	}
+
+	PLAYERMOVETO_VLOG_LOCATION(OwnerTask, LogGameplayTasks, Log, BestCandidate->Location, 30.f, FColor::Green, TEXT("FPlayerMoveToDriver::SelectNearestGoal selected goal %d out of %d"),
+		BestCandidate->Index, GoalLocations.Num() + GoalActors.Num());
+
+	MoveRequest = MakeMoveRequest(MoveRequest, BestCandidate->Location, BestCandidate->Actor);
+	if (BestCandidate->Actor == nullptr)
+	{
+		// already projected
+		MoveRequest.SetProjectGoalLocation(MoveRequest.IsProjectingGoal() && NavData == nullptr);
+	}
+
+	PrecomputedPath = BestPath;
+	return BestCandidate->Index;
+}
+
+bool FPlayerMoveToDriver::FindPathAsyncForMoveRequest(const FAIMoveRequest& InMoveRequest, const FPathFindingQuery& Query, bool bOnWorker)
+{
+	AbortAsyncPathRequest();
+
+	const FNavPathQueryDelegate OnPathFound = FNavPathQueryDelegate::CreateWeakLambda(OwnerTask,
+		[this](uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr InPath)
+		{
+			OnAsyncPathFound(QueryID, Result, InPath);
+		});
+
+	UPlayerMoveToQuerySubsystem* QuerySubsystem = bOnWorker ? UPlayerMoveToQuerySubsystem::Get(GetWorld()) : nullptr;
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (QuerySubsystem)
+	{
+		AsyncPathCacheKey = FPlayerMovePathCacheKey(Query, OwnerController->GetNavAgentPropertiesRef(), InMoveRequest.GetNavigationFilter());
+		AsyncPathQueryID = QuerySubsystem->FindPathAsync(Query, OnPathFound);
+		bAsyncPathQueryOnWorker = true;
+	}
+	else if (NavSys)
+	{
+		AsyncPathCacheKey = FPlayerMovePathCacheKey(Query, OwnerController->GetNavAgentPropertiesRef(), InMoveRequest.GetNavigationFilter());
+		AsyncPathQueryID = NavSys->FindPathAsync(OwnerController->GetNavAgentPropertiesRef(), Query, OnPathFound);
+		bAsyncPathQueryOnWorker = false;
+	}
+
+	PLAYERMOVETO_CVLOG(AsyncPathQueryID == INVALID_NAVQUERYID, OwnerTask, LogGameplayTasks, Error, TEXT("Failed to submit async path query to %s")
+		, InMoveRequest.IsMoveToActorRequest() ? *GetNameSafe(InMoveRequest.GetGoalActor()) : *InMoveRequest.GetGoalLocation().ToString());
+
+	return AsyncPathQueryID != INVALID_NAVQUERYID;
+}
+
+void FPlayerMoveToDriver::OnAsyncPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr InPath)
+{
+	if (QueryID != AsyncPathQueryID)
+	{
+		return;
+	}
+
+	AsyncPathQueryID = INVALID_NAVQUERYID;
+
+	if (!OwnerTask->IsActive() || PathFollowingComp == nullptr)
+	{
+		return;
+	}
+
+	if (Result == ENavigationQueryResult::Success && InPath.IsValid())
+	{
+		if (UPlayerMoveToCacheSubsystem* PathCache = UPlayerMoveToCacheSubsystem::Get(GetWorld()))
+		{
+			PathCache->AddPath(AsyncPathCacheKey, InPath);
+		}
+
+		PrepareFoundPath(MoveRequest, InPath);
+		SmoothFoundPath(InPath);
+
+		if (RequestMoveOnPath(InPath))
+		{
+			return;
+		}
+	}
+	else
+	{
+		PLAYERMOVETO_VLOG(OwnerTask, LogGameplayTasks, Error, TEXT("Async path query to %s failed")
+			, MoveRequest.IsMoveToActorRequest() ? *GetNameSafe(MoveRequest.GetGoalActor()) : *MoveRequest.GetGoalLocation().ToString());
+	}
+
+	FinishMoveTask(EPathFollowingResult::Invalid);
+}
+
+bool FPlayerMoveToDriver::RequestMoveOnPath(const FNavPathSharedPtr& InPath)
+{
+	PLAYERMOVETO_SCOPE(RequestMove);
+
+	const FAIRequestID RequestID = PathFollowingComp ? PathFollowingComp->RequestMove(MoveRequest, InPath) : FAIRequestID::InvalidRequest;
+	if (!RequestID.IsValid())
+	{
+		return false;
+	}
+
+	MoveRequestID = RequestID;
+	if (!PathFinishDelegateHandle.IsValid())
+	{
+		PathFinishDelegateHandle = PathFollowingComp->OnRequestFinished.AddWeakLambda(OwnerTask,
+			[this](FAIRequestID FinishedRequestID, const FPathFollowingResult& FinishedResult) { OnRequestFinished(FinishedRequestID, FinishedResult); });
+	}
+	SetObservedPath(InPath);
+	return true;
+}
+
+void FPlayerMoveToDriver::AbortAsyncPathRequest()
+{
+	if (AsyncPathQueryID != INVALID_NAVQUERYID)
+	{
+		if (bAsyncPathQueryOnWorker)
+		{
+			if (UPlayerMoveToQuerySubsystem* QuerySubsystem = UPlayerMoveToQuerySubsystem::Get(GetWorld()))
+			{
+				QuerySubsystem->AbortQuery(AsyncPathQueryID);
+			}
+		}
+		else if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			NavSys->AbortAsyncFindPathRequest(AsyncPathQueryID);
+		}
+
+		AsyncPathQueryID = INVALID_NAVQUERYID;
+	}
+}
+
+void FPlayerMoveToDriver::Pause()
+{
+	if (PathFollowingComp && MoveRequestID.IsValid())
+	{
+		PathFollowingComp->PauseMove(MoveRequestID);
+	}
+
+	ResetTimers();
+	AbortAsyncPathRequest();
+}
+
+void FPlayerMoveToDriver::Resume()
+{
+	const bool bRetarget = bPendingRetarget;
+	bPendingRetarget = false;
+
+	// paused request can't move to a new goal actor, it is replaced by a new one instead of resumed
+	const bool bCanResume = !bRetarget || bPendingRetargetKeepsRequest;
+	if (bCanResume && MoveRequestID.IsValid() && ResumeMove(MoveRequestID))
+	{
+		// Pause cleared all timers of the task
+		StartGoalTracking();
+		StartRouteUpdates();
+		StartNetPathUpdates();
+		if (bPredictionReportPending && Path.IsValid())
+		{
+			ReportPredictedPath(*Path);
+		}
+
+		if (bRetarget)
+		{
+			ApplyRetarget(bPendingRetargetKeepsRequest, bPendingRetargetReusesPrefix);
+		}
+	}
+	else
+	{
+		PLAYERMOVETO_CVLOG(bCanResume && MoveRequestID.IsValid(), GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> Resume move failed, starting new one."), *GetName());
+		ConditionalPerformMove();
+	}
+}
+
+bool FPlayerMoveToDriver::ResumeMove(FAIRequestID RequestToResume) const
+{
+	if (PathFollowingComp != nullptr && RequestToResume.IsEquivalent(PathFollowingComp->GetCurrentRequestId()))
+	{
+		PathFollowingComp->ResumeMove(RequestToResume);
+		return true;
+	}
+	return false;
+}
+
+void FPlayerMoveToDriver::SetObservedPath(const FNavPathSharedPtr& InPath)
+{
+	if (PathUpdateDelegateHandle.IsValid() && Path.IsValid())
+	{
+		Path->RemoveObserver(PathUpdateDelegateHandle);
+	}
+
+	PathUpdateDelegateHandle.Reset();
+
+	Path = InPath;
+	if (Path.IsValid())
+	{
+		// disable auto repaths, it will be handled by move task to include ShouldPostponePathUpdates condition
+		Path->EnableRecalculationOnInvalidation(false);
+		OnFollowedPathUpdated(*Path);
+		PathUpdateDelegateHandle = Path->AddObserver(FNavigationPath::FPathObserverDelegate::FDelegate::CreateWeakLambda(OwnerTask,
+			[this](FNavigationPath* UpdatedPath, ENavPathEvent::Type Event) { OnPathEvent(UpdatedPath, Event); }));
+	}
+}
+
+void FPlayerMoveToDriver::RecordPathTelemetry(const FNavigationPath& InPath)
+{
+	if (Telemetry.TimeToFirstPath < 0.f)
+	{
+		Telemetry.TimeToFirstPath = FPlatformTime::Seconds() - ActivationRealTime;
+	}
+
+	Telemetry.PathLength = InPath.GetLength();
+	Telemetry.NumPathPoints = InPath.GetPathPoints().Num();
+	Telemetry.bPartialPath = InPath.IsPartial();
+}
+
+void FPlayerMoveToDriver::RecordTelemetry(EPathFollowingResult::Type InResult)
+{
+	bTelemetryRecorded = true;
+
+	const AActor* GoalActor = MoveRequest.GetGoalActor();
+	Telemetry.GoalLocation = GoalActor ? GoalActor->GetActorLocation() : MoveRequest.GetGoalLocation();
+	Telemetry.GoalActorName = GoalActor ? GoalActor->GetFName() : NAME_None;
+	Telemetry.Duration = GetWorld() ? GetWorld()->GetTimeSeconds() - ActivationGameTime : 0.f;
+	Telemetry.Result = InResult;
+
+	if (UPlayerMoveToTelemetrySubsystem* TelemetrySubsystem = UPlayerMoveToTelemetrySubsystem::Get(GetWorld()))
+	{
+		TelemetrySubsystem->AddRecord(Telemetry);
+	}
+}
+
+void FPlayerMoveToDriver::OnFollowedPathUpdated(const FNavigationPath& InPath)
+{
+	// goal actors off navigation or behind partial paths are never at the end of the path, goal observation compares with this instead
+	if (OwnerController && MoveRequest.IsMoveToActorRequest() && MoveRequest.GetGoalActor())
+	{
+		ObservedGoalLocation = GetMoveGoalLocation(MoveRequest);
+	}
+
+	RecordPathTelemetry(InPath);
+	ReportPredictedPath(InPath);
+	ReplicateFollowedPath(InPath);
+}
+
+void FPlayerMoveToDriver::ReplicateFollowedPath(const FNavigationPath& InPath)
+{
+	APlayerAIMoveToController* MoveToController = Cast<APlayerAIMoveToController>(OwnerController);
+	if (!bReplicatePath || MoveToController == nullptr || !MoveToController->HasAuthority() || MoveToController->IsLocalController() || !MoveRequestID.IsValid())
+	{
+		return;
+	}
+
+	const TArray<FNavPathPoint>& PathPoints = InPath.GetPathPoints();
+	if (PathPoints.Num() == 0)
+	{
+		return;
+	}
+
+	// bandwidth is bounded by sending a window of the path starting at the segment pawn is on, UpdateNetPathWindow moves it forward
+	const int32 StartIndex = GetNetPathStartIndex(InPath);
+	const int32 EndIndex = FMath::Min(PathPoints.Num(), StartIndex + FMath::Max(2, PlayerMoveToCVars::NetPathMaxPoints));
+	TArray<FVector> QuantizedPoints;
+	QuantizedPoints.Reserve(EndIndex - StartIndex);
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		QuantizedPoints.Add(FPlayerMoveNetPath::Quantize(PathPoints[Index].Location));
+	}
+
+	FPlayerMoveNetPath NetPath;
+	NetPath.MoveId = MoveRequestID.GetID();
+	NetPath.StartIndex = StartIndex;
+	NetPath.FirstPointIndex = StartIndex;
+	NetPath.bPartial = InPath.IsPartial();
+	if (NetPath.MoveId == ReplicatedMoveId && StartIndex >= ReplicatedPathStartIndex)
+	{
+		// client keeps the points of its window that didn't change
+		const int32 ReplicatedEndIndex = ReplicatedPathStartIndex + ReplicatedPathPoints.Num();
+		while (NetPath.FirstPointIndex < EndIndex && NetPath.FirstPointIndex < ReplicatedEndIndex &&
+			QuantizedPoints[NetPath.FirstPointIndex - StartIndex] == ReplicatedPathPoints[NetPath.FirstPointIndex - ReplicatedPathStartIndex])
+		{
+			NetPath.FirstPointIndex++;
+		}
+
+		if (NetPath.FirstPointIndex == EndIndex && EndIndex == ReplicatedEndIndex && StartIndex == ReplicatedPathStartIndex)
+		{
+			return;
+		}
+	}
+
+	NetPath.PathPoints.Append(QuantizedPoints.GetData() + NetPath.FirstPointIndex - StartIndex, EndIndex - NetPath.FirstPointIndex);
+	ReplicatedMoveId = NetPath.MoveId;
+	ReplicatedPathStartIndex = StartIndex;
+	ReplicatedPathPoints = MoveTemp(QuantizedPoints);
+	MoveToController->ClientSetFollowedPath(NetPath);
+
+	if (EndIndex < PathPoints.Num())
+	{
+		StartNetPathUpdates();
+	}
+}
+
+int32 FPlayerMoveToDriver::GetNetPathStartIndex(const FNavigationPath& InPath) const
+{
+	// points before the segment pawn is on were already passed
+	if (PathFollowingComp && PathFollowingComp->GetPath().Get() == &InPath)
+	{
+		return FMath::Clamp(PathFollowingComp->GetCurrentPathIndex(), 0, FMath::Max(0, InPath.GetPathPoints().Num() - 2));
+	}
+	return 0;
+}
+
+void FPlayerMoveToDriver::StartNetPathUpdates()
+{
+	UWorld* World = GetWorld();
+	if (ReplicatedMoveId != 0 && World && !World->GetTimerManager().IsTimerActive(NetPathTimerHandle))
+	{
+		World->GetTimerManager().SetTimer(NetPathTimerHandle,
+			FTimerDelegate::CreateWeakLambda(OwnerTask, [this]() { UpdateNetPathWindow(); }), FMath::Max(0.01f, PlayerMoveToCVars::FollowInterval), true);
+	}
+}
+
+void FPlayerMoveToDriver::UpdateNetPathWindow()
+{
+	const int32 ReplicatedEndIndex = ReplicatedPathStartIndex + ReplicatedPathPoints.Num();
+	if (ReplicatedMoveId == 0 || !Path.IsValid() || ReplicatedEndIndex >= Path->GetPathPoints().Num())
+	{
+		// client has the rest of the path, next path update restarts the timer if it needs to
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(NetPathTimerHandle);
+		}
+		return;
+	}
+
+	// move the window once less than half of it is left ahead of the pawn
+	const int32 StartIndex = GetNetPathStartIndex(*Path);
+	if (StartIndex < ReplicatedPathStartIndex || StartIndex + FMath::Max(2, PlayerMoveToCVars::NetPathMaxPoints) / 2 > ReplicatedEndIndex)
+	{
+		ReplicateFollowedPath(*Path);
+	}
+}
+
+void FPlayerMoveToDriver::StopReplicatingPath()
+{
+	if (ReplicatedMoveId != 0)
+	{
+		if (APlayerAIMoveToController* MoveToController = Cast<APlayerAIMoveToController>(OwnerController))
+		{
+			MoveToController->ClientClearFollowedPath(ReplicatedMoveId);
+		}
+	}
+
+	ReplicatedMoveId = 0;
+	ReplicatedPathStartIndex = 0;
+	ReplicatedPathPoints.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(NetPathTimerHandle);
+	}
+}
+
+bool FPlayerMoveToDriver::IsPredictingClient() const
+{
+	// listen server's own player and server side moves have nobody to report to
+	return bUseClientPrediction && OwnerController && OwnerController->IsLocalController() && !OwnerController->HasAuthority() &&
+		OwnerController->IsA<APlayerAIMoveToController>();
+}
+
+void FPlayerMoveToDriver::ReportPredictedPath(const FNavigationPath& InPath)
+{
+	if (!IsPredictingClient() || !MoveRequestID.IsValid())
+	{
+		return;
+	}
+
+	APlayerAIMoveToController* MoveToController = CastChecked<APlayerAIMoveToController>(OwnerController);
+	if (!PredictionRejectedHandle.IsValid())
+	{
+		PredictionRejectedHandle = MoveToController->OnPredictedPathRejected.AddWeakLambda(OwnerTask, [this](uint32 MoveId)
+		{
+			if (MoveId == PredictedMoveId)
+			{
+				PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> server rejected predicted path, aborting"), *GetName());
+				PredictedMoveId = 0;
+				FinishMoveTask(EPathFollowingResult::Aborted);
+			}
+		});
+	}
+
+	// updates of the same move are rate limited, repaths of a tracked goal would otherwise flood the reliable channel
+	UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+	const double ReportDelay = LastPredictionReportTime + PlayerMoveToCVars::PredictionReportInterval - Now;
+	if (World && PredictedMoveId == MoveRequestID.GetID() && ReportDelay > UE_KINDA_SMALL_NUMBER)
+	{
+		// sent later with whatever path is followed by then
+		bPredictionReportPending = true;
+		if (!World->GetTimerManager().IsTimerActive(PredictionReportTimerHandle))
+		{
+			World->GetTimerManager().SetTimer(PredictionReportTimerHandle, FTimerDelegate::CreateWeakLambda(OwnerTask, [this]()
+			{
+				if (bPredictionReportPending && Path.IsValid())
+				{
+					ReportPredictedPath(*Path);
+				}
+			}), ReportDelay, false);
+		}
+		return;
+	}
+
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(PredictionReportTimerHandle);
+	}
+
+	bPredictionReportPending = false;
+	LastPredictionReportTime = Now;
+	PredictedMoveId = MoveRequestID.GetID();
+	MoveToController->ServerSetPredictedPath(FPlayerMovePathDigest(PredictedMoveId, InPath, MoveRequest.GetNavigationFilter()));
+}
+
+void FPlayerMoveToDriver::StopPredictedPath()
+{
+	APlayerAIMoveToController* MoveToController = Cast<APlayerAIMoveToController>(OwnerController);
+	if (MoveToController && PredictionRejectedHandle.IsValid())
+	{
+		MoveToController->OnPredictedPathRejected.Remove(PredictionRejectedHandle);
+	}
+	PredictionRejectedHandle.Reset();
+
+	if (MoveToController && PredictedMoveId != 0)
+	{
+		MoveToController->ServerClearPredictedPath(PredictedMoveId);
+	}
+	PredictedMoveId = 0;
+	bPredictionReportPending = false;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PredictionReportTimerHandle);
+	}
+}
+
+void FPlayerMoveToDriver::ResetObservers()
+{
+	if (Path.IsValid())
+	{
+		Path->DisableGoalActorObservation();
+	}
+
+	if (PathFinishDelegateHandle.IsValid())
+	{
+		if (PathFollowingComp)
+		{
+			PathFollowingComp->OnRequestFinished.Remove(PathFinishDelegateHandle);
+		}
+
+		PathFinishDelegateHandle.Reset();
+	}
+
+	if (PathUpdateDelegateHandle.IsValid())
+	{
+		if (Path.IsValid())
+		{
+			Path->RemoveObserver(PathUpdateDelegateHandle);
+		}
+
+		PathUpdateDelegateHandle.Reset();
+	}
+}
+
+void FPlayerMoveToDriver::ResetTimers()
+{
+	if (OwnerController)
+	{
+		// Remove all timers including the ones that might have been set with SetTimerForNextTick
+		OwnerController->GetWorldTimerManager().ClearAllTimersForObject(OwnerTask);
+	}
+	StopWaitingForNavigation(MoveRetryHandle);
+	StopWaitingForNavigation(PathRetryHandle);
+	GoalTrackingTimerHandle.Invalidate();
+	RouteTimerHandle.Invalidate();
+	NetPathTimerHandle.Invalidate();
+	PredictionReportTimerHandle.Invalidate();
+}
+
+FDelegateHandle FPlayerMoveToDriver::WaitForNavigation(TFunction<void()>&& Retry)
+{
+	if (UPlayerMoveToNavReadySubsystem* NavReady = UPlayerMoveToNavReadySubsystem::Get(GetWorld()))
+	{
+		return NavReady->WaitForNavigation(FSimpleDelegate::CreateWeakLambda(OwnerTask, MoveTemp(Retry)));
+	}
+
+	// no shared waiting list in this world, poll on our own
+	FTimerHandle RetryTimerHandle;
+	OwnerController->GetWorldTimerManager().SetTimer(RetryTimerHandle,
+		FTimerDelegate::CreateWeakLambda(OwnerTask, MoveTemp(Retry)), 0.2f, false);
+	return FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+}
+
+void FPlayerMoveToDriver::StopWaitingForNavigation(FDelegateHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		if (UPlayerMoveToNavReadySubsystem* NavReady = UPlayerMoveToNavReadySubsystem::Get(GetWorld()))
+		{
+			NavReady->StopWaiting(Handle);
+		}
+		Handle.Reset();
+	}
+}
+
+void FPlayerMoveToDriver::Cleanup()
+{
+	if (bCountedAsActive)
+	{
+		// cancelled from outside before it could finish
+		if (!bTelemetryRecorded)
+		{
+			RecordTelemetry(EPathFollowingResult::Aborted);
+		}
+
+		bCountedAsActive = false;
+		DEC_DWORD_STAT(STAT_PlayerMoveTo_ActiveTasks);
+		TRACE_COUNTER_DECREMENT(PlayerMoveTo_ActiveTasks);
+	}
+
+	StopPredictedPath();
+	StopReplicatingPath();
+	ResetObservers();
+	ResetTimers();
+	AbortAsyncPathRequest();
+
+	if (MoveRequestID.IsValid())
+	{
+		if (PathFollowingComp && PathFollowingComp->GetStatus() != EPathFollowingStatus::Idle)
+		{
+			PathFollowingComp->AbortMove(*OwnerTask, FPathFollowingResultFlags::OwnerFinished, MoveRequestID);
+		}
+	}
+
+	// clear the shared pointer now to make sure other systems
+	// don't think this path is still being used
+	Path = nullptr;
+	PrecomputedPath = nullptr;
+}
+
+void FPlayerMoveToDriver::OnRequestFinished(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	if (RequestID == MoveRequestID)
+	{
+		if (Result.HasFlag(FPathFollowingResultFlags::UserAbort) && Result.HasFlag(FPathFollowingResultFlags::NewRequest) && !Result.HasFlag(FPathFollowingResultFlags::ForcedScript))
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> ignoring OnRequestFinished, move was aborted by new request"), *GetName());
+		}
+		else
+		{
+			// reset request Id, FinishMoveTask doesn't need to update path following's state
+			MoveRequestID = FAIRequestID::InvalidRequest;
+
+			if (Result.IsSuccess() && !bOnFinalLeg && IsFollowingRoute())
+			{
+				if (CanAdvanceRoute())
+				{
+					// next leg wasn't searched in time, continue from here
+					PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> reached end of route leg, requesting next one"), *GetName());
+					ConditionalPerformMove();
+				}
+				else
+				{
+					PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> reached end of loaded navigation, waiting for it to stream in"), *GetName());
+					bHoldingAtRouteEnd = true;
+					StartRouteUpdates();
+				}
+			}
+			else if (IsTrackingGoal() && Result.IsSuccess())
+			{
+				// keep the path, it is retargeted once goal actor moves out of reach
+				PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> received OnRequestFinished and goal tracking is active! Holding until goal moves"), *GetName());
+				bHoldingAtGoal = true;
+				StartGoalTracking();
+			}
+			else
+			{
+				FinishMoveTask(Result.Code);
+			}
+		}
+	}
+	else if (OwnerTask->IsActive())
+	{
+		PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Warning, TEXT("%s> received OnRequestFinished with not matching RequestID!"), *GetName());
+	}
+}
+
+void FPlayerMoveToDriver::OnPathEvent(FNavigationPath* InPath, ENavPathEvent::Type Event)
+{
+#if WITH_PLAYERMOVETO_DEBUG
+	const static UEnum* NavPathEventEnum = StaticEnum<ENavPathEvent::Type>();
+	PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> Path event: %s"), *GetName(), *NavPathEventEnum->GetNameStringByValue(Event));
+#endif
+
+	switch (Event)
+	{
+	case ENavPathEvent::NewPath:
+	case ENavPathEvent::UpdatedDueToGoalMoved:
+	case ENavPathEvent::UpdatedDueToNavigationChanged:
+		if (InPath)
+		{
+			Telemetry.NumRepaths += Event != ENavPathEvent::NewPath ? 1 : 0;
+			OnFollowedPathUpdated(*InPath);
+		}
+
+		// route legs can end short, the route continues from wherever they got
+		if (InPath && InPath->IsPartial() && !MoveRequest.IsUsingPartialPaths() && bOnFinalLeg)
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT(">> partial path is not allowed, aborting"));
+#if WITH_PLAYERMOVETO_DEBUG
+			UPathFollowingComponent::LogPathHelper(OwnerController, InPath, MoveRequest.GetGoalActor());
+#endif
+			FinishMoveTask(EPathFollowingResult::Aborted);
+		}
+#if ENABLE_VISUAL_LOG && WITH_PLAYERMOVETO_DEBUG
+		else if (!OwnerTask->IsActive())
+		{
+			UPathFollowingComponent::LogPathHelper(OwnerController, InPath, MoveRequest.GetGoalActor());
+		}
+#endif // ENABLE_VISUAL_LOG && WITH_PLAYERMOVETO_DEBUG
+		break;
+
+	case ENavPathEvent::Invalidated:
+		// nothing to repath while holding at goal, goal tracking requests a new path once needed
+		if (!bHoldingAtGoal)
+		{
+			ConditionalUpdatePath();
+		}
+		break;
+
+	case ENavPathEvent::Cleared:
+	case ENavPathEvent::RePathFailed:
+		PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT(">> no path, aborting!"));
+		FinishMoveTask(EPathFollowingResult::Aborted);
+		break;
+
+	case ENavPathEvent::MetaPathUpdate:
+	default:
+		break;
+	}
+}
+
+void FPlayerMoveToDriver::ResetForReuse()
+{
+	// stops everything that could still call back into this driver
+	Cleanup();
+
+	OwnerController = nullptr;
+	PathFollowingComp = nullptr;
+	Path.Reset();
+	PrecomputedPath.Reset();
+	MoveRequestID = FAIRequestID::InvalidRequest;
+	AsyncPathCacheKey = FPlayerMovePathCacheKey();
+
+	MoveRequest = FAIMoveRequest();
+	MoveRequest.SetAcceptanceRadius(GET_AI_CONFIG_VAR(AcceptanceRadius));
+	MoveRequest.SetReachTestIncludesAgentRadius(GET_AI_CONFIG_VAR(bFinishMoveOnGoalOverlap));
+	MoveRequest.SetAllowPartialPath(GET_AI_CONFIG_VAR(bAcceptPartialPaths));
+	MoveRequest.SetUsePathfinding(true);
+	GoalObservation = FPlayerMoveGoalObservation();
+
+	Telemetry = FPlayerMoveTelemetry();
+	MoveResult = EPathFollowingResult::Invalid;
+	bUseContinuousTracking = false;
+	bUseAsyncPathfinding = false;
+	bAsyncPathQueryOnWorker = false;
+	bTelemetryRecorded = false;
+	bHoldingAtGoal = false;
+	bUseHierarchicalPathfinding = false;
+	bUseStreamingGoal = false;
+	bOnFinalLeg = true;
+	bHoldingAtRouteEnd = false;
+	bUseClientPrediction = false;
+	bReplicatePath = false;
+	bPendingRetarget = false;
+	bPendingRetargetKeepsRequest = false;
+	bPendingRetargetReusesPrefix = false;
+	bPredictionReportPending = false;
+	RouteWaypoints.Reset();
+	RouteWaypointIndex = 0;
+	NumPathExtensions = 0;
+	LastGoalRepathTime = -UE_BIG_NUMBER;
+	LastPredictionReportTime = -UE_BIG_NUMBER;
+	ObservedGoalLocation = FAISystem::InvalidLocation;
+	ActivationRealTime = 0.0;
+	ActivationGameTime = 0.0;
+}
+
+void FPlayerMoveToDriver::ConditionalUpdatePath()
+{
+	PLAYERMOVETO_SCOPE(Repath);
+
+	// mark this path as waiting for repath so that PathFollowingComponent doesn't abort the move while we
+	// micro manage repathing moment
+	// note that this flag fill get cleared upon repathing end
+	if (Path.IsValid())
+	{
+		Path->SetManualRepathWaiting(true);
+	}
+
+	if (MoveRequest.IsUsingPathfinding() && OwnerController && OwnerController->ShouldPostponePathUpdates())
+	{
+		PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> can't path right now, waiting..."), *GetName());
+		INC_DWORD_STAT(STAT_PlayerMoveTo_RepathRetries);
+		Telemetry.NumRetries++;
+		TRACE_COUNTER_INCREMENT(PlayerMoveTo_Retries);
+		if (!PathRetryHandle.IsValid())
+		{
+			PathRetryHandle = WaitForNavigation([this]()
+			{
+				PathRetryHandle.Reset();
+				ConditionalUpdatePath();
+			});
+		}
+	}
+	else
+	{
+		StopWaitingForNavigation(PathRetryHandle);
+
+		ANavigationData* NavData = Path.IsValid() ? Path->GetNavigationDataUsed() : nullptr;
+		if (NavData && RepairPath(*NavData))
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> repaired invalidated path"), *GetName());
+		}
+		else if (NavData)
+		{
+			NavData->RequestRePath(Path, ENavPathUpdateType::NavigationChanged);
+		}
+		else
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> unable to repath, aborting!"), *GetName());
+			FinishMoveTask(EPathFollowingResult::Aborted);
+		}
+	}
+}
+
+bool FPlayerMoveToDriver::RepairPath(ANavigationData& NavData)
+{
+	PLAYERMOVETO_SCOPE(PathRepair);
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!PlayerMoveToCVars::bRepairPaths || NavSys == nullptr || PathFollowingComp == nullptr || !MoveRequest.IsUsingPathfinding())
+	{
+		return false;
+	}
+
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	const int32 CurrentIndex = PathFollowingComp->GetCurrentPathIndex();
+	if (!PathPoints.IsValidIndex(CurrentIndex + 1))
+	{
+		return false;
+	}
+
+	// walk path from the pawn, first blocked segment ends the part that is still walkable
+	const FVector PawnLocation = OwnerController->GetNavAgentLocation();
+	int32 LastValidIndex = INDEX_NONE;
+	FVector SegmentStart = PawnLocation;
+	for (int32 Index = CurrentIndex + 1; Index < PathPoints.Num(); Index++)
+	{
+		if (!HasNavigationLineOfSight(NavData, SegmentStart, PathPoints[Index].Location))
+		{
+			break;
+		}
+		LastValidIndex = Index;
+		SegmentStart = PathPoints[Index].Location;
+	}
+
+	// kept part has to be on polys that still exist, or its corridor would point at rebuilt tiles
+	if (LastValidIndex != INDEX_NONE)
+	{
+		LastValidIndex = PlayerMoveToDriver::GetLastValidCorridorIndex(NavData, *Path, CurrentIndex, LastValidIndex);
+	}
+
+	// pawn can't reach anything on the path, nothing to keep
+	if (LastValidIndex <= CurrentIndex)
+	{
+		return false;
+	}
+
+	// kept points are copied whole, navigation links on them still have to trigger
+	TArray<FNavPathPoint> RepairedPoints;
+	RepairedPoints.Add(FNavPathPoint(PawnLocation, PathPoints[CurrentIndex].NodeRef));
+	RepairedPoints.Append(PathPoints.GetData() + CurrentIndex + 1, LastValidIndex - CurrentIndex);
+
+	FNavPathSharedPtr TailPath;
+	if (LastValidIndex < PathPoints.Num() - 1)
+	{
+		const FSharedConstNavQueryFilter NavFilter = UNavigationQueryFilter::GetQueryFilter(NavData, OwnerTask, MoveRequest.GetNavigationFilter());
+		FPathFindingQuery TailQuery(OwnerController, NavData, PathPoints[LastValidIndex].Location, GetMoveGoalLocation(MoveRequest), NavFilter);
+		TailQuery.SetAllowPartialPaths(MoveRequest.IsUsingPartialPaths());
+
+		PLAYERMOVETO_SCOPE(PathSearch);
+		const FPathFindingResult TailResult = NavSys->FindPathSync(TailQuery);
+		if (!TailResult.IsSuccessful() || !TailResult.Path.IsValid() || TailResult.Path->GetPathPoints().Num() < 2)
+		{
+			return false;
+		}
+
+		TailPath = TailResult.Path;
+		RepairedPoints.Append(TailPath->GetPathPoints().GetData() + 1, TailPath->GetPathPoints().Num() - 1);
+	}
+
+	// walkable part keeps its corridor, so rebuilds of tiles under it still invalidate the path
+	UpdatePathInPlace(MoveTemp(RepairedPoints), TailPath.Get(), ENavPathUpdateType::NavigationChanged, CurrentIndex, LastValidIndex);
+	return true;
+}
+
+void FPlayerMoveToDriver::UpdatePathInPlace(TArray<FNavPathPoint>&& NewPoints, const FNavigationPath* SearchedPath, ENavPathUpdateType::Type UpdateType,
+	int32 KeptFirstIndex, int32 KeptLastIndex)
+{
+#if WITH_RECAST
+	FNavMeshPath* MeshPath = Path->CastPath<FNavMeshPath>();
+	const FNavMeshPath* SearchedMeshPath = SearchedPath ? SearchedPath->CastPath<FNavMeshPath>() : nullptr;
+	TArray<NavNodeRef> Corridor;
+	TArray<FVector::FReal> CorridorCost;
+	decltype(FNavMeshPath::CustomLinkIds) CustomLinkIds;
+	if (MeshPath)
+	{
+		// kept points go through the same polys as before, that part of the corridor stays
+		const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+		const TArray<NavNodeRef>& PathCorridor = MeshPath->PathCorridor;
+		if (PathPoints.IsValidIndex(KeptFirstIndex) && PathPoints.IsValidIndex(KeptLastIndex) && PathCorridor.Num() > 0)
+		{
+			int32 CorridorStart = PathCorridor.IndexOfByKey(PathPoints[KeptFirstIndex].NodeRef);
+			CorridorStart = CorridorStart == INDEX_NONE ? 0 : CorridorStart;
+			int32 CorridorEnd = PathCorridor.Num() - 1;
+			for (int32 CorridorIndex = CorridorStart; CorridorIndex < PathCorridor.Num(); CorridorIndex++)
+			{
+				if (PathCorridor[CorridorIndex] == PathPoints[KeptLastIndex].NodeRef)
+				{
+					CorridorEnd = CorridorIndex;
+					break;
+				}
+			}
+
+			for (int32 CorridorIndex = CorridorStart; CorridorIndex <= CorridorEnd; CorridorIndex++)
+			{
+				Corridor.Add(PathCorridor[CorridorIndex]);
+				CorridorCost.Add(MeshPath->PathCorridorCost.IsValidIndex(CorridorIndex) ? MeshPath->PathCorridorCost[CorridorIndex] : 0.f);
+			}
+
+			for (int32 Index = KeptFirstIndex; Index <= KeptLastIndex; Index++)
+			{
+				if (PathPoints[Index].CustomLinkId != 0)
+				{
+					CustomLinkIds.AddUnique(PathPoints[Index].CustomLinkId);
+				}
+			}
+		}
+
+		if (SearchedMeshPath)
+		{
+			// searched part starts on the poly kept part ends on
+			const TArray<NavNodeRef>& SearchedCorridor = SearchedMeshPath->PathCorridor;
+			const int32 FirstSearchedIndex = Corridor.Num() > 0 && SearchedCorridor.Num() > 0 && Corridor.Last() == SearchedCorridor[0] ? 1 : 0;
+			for (int32 CorridorIndex = FirstSearchedIndex; CorridorIndex < SearchedCorridor.Num(); CorridorIndex++)
+			{
+				Corridor.Add(SearchedCorridor[CorridorIndex]);
+				CorridorCost.Add(SearchedMeshPath->PathCorridorCost.IsValidIndex(CorridorIndex) ? SearchedMeshPath->PathCorridorCost[CorridorIndex] : 0.f);
+			}
+
+			for (const auto& CustomLinkId : SearchedMeshPath->CustomLinkIds)
+			{
+				CustomLinkIds.AddUnique(CustomLinkId);
+			}
+		}
+	}
+#endif
+
+	// same as navigation data does when it repaths, path following reacts to DoneUpdating
+	const bool bWasPartial = Path->IsPartial();
+	Path->ResetForRepath();
+	Path->GetPathPoints() = MoveTemp(NewPoints);
+	Path->SetIsPartial(SearchedPath ? SearchedPath->IsPartial() : bWasPartial);
+	if (SearchedPath)
+	{
+		// later repaths head to the searched goal
+		Path->SetQueryData(SearchedPath->GetQueryData());
+	}
+
+#if WITH_RECAST
+	if (MeshPath)
+	{
+		MeshPath->PathCorridor = MoveTemp(Corridor);
+		MeshPath->PathCorridorCost = MoveTemp(CorridorCost);
+		MeshPath->CustomLinkIds = MoveTemp(CustomLinkIds);
+	}
+#endif
+
+	Path->MarkReady();
+	Path->DoneUpdating(UpdateType);
+}
+
+bool FPlayerMoveToDriver::IsFollowingRoute() const
+{
+	return (UsesRouteLegs() || bUseStreamingGoal) && MoveRequest.IsUsingPathfinding() && !MoveRequest.IsMoveToActorRequest();
+}
+
+bool FPlayerMoveToDriver::UsesRouteLegs() const
+{
+	return bUseHierarchicalPathfinding && PlayerMoveToCVars::RouteLegDistance > 0.f;
+}
+
+FVector FPlayerMoveToDriver::GetRouteProjectionExtent(const ANavigationData& NavData)
+{
+	// coarse route doesn't follow navigation, look for it in a wider area
+	return NavData.GetDefaultQueryExtent() * FVector(4.f, 4.f, 2.f);
+}
+
+bool FPlayerMoveToDriver::FindLoadedNavigationTowards(const FPathFindingQuery& Query, const FVector& Goal, FVector& OutLocation) const
+{
+	const ANavigationData* NavData = Query.NavData.Get();
+	const FVector::FReal Distance = FVector::Dist(Query.StartLocation, Goal);
+	if (NavData == nullptr || Distance <= UE_KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	// step back from the goal, first point on navigation is the closest loaded one
+	const FVector Extent = GetRouteProjectionExtent(*NavData);
+	const int32 NumProbes = FMath::Clamp(FMath::CeilToInt32(Distance / FMath::Max(1.f, PlayerMoveToCVars::StreamingProbeStep)), 1, FMath::Max(1, PlayerMoveToCVars::StreamingMaxProbes));
+	for (int32 ProbeIndex = 1; ProbeIndex < NumProbes; ProbeIndex++)
+	{
+		const FVector Probe = FMath::Lerp(Goal, Query.StartLocation, static_cast<FVector::FReal>(ProbeIndex) / NumProbes);
+		FNavLocation ProjectedProbe;
+		if (NavData->ProjectPoint(Probe, ProjectedProbe, Extent, Query.QueryFilter, Query.Owner.Get()))
+		{
+			OutLocation = ProjectedProbe.Location;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FPlayerMoveToDriver::FindRouteLeg(const FPathFindingQuery& Query, int32& InOutWaypointIndex, FVector& OutLegGoal) const
+{
+	const ANavigationData* NavData = Query.NavData.Get();
+	if (!IsFollowingRoute() || NavData == nullptr)
+	{
+		return false;
+	}
+
+	const bool bHasLeg = UsesRouteLegs() && GetRouteLegGoal(Query.StartLocation, Query.EndLocation, InOutWaypointIndex, OutLegGoal);
+	const FVector LegGoal = bHasLeg ? OutLegGoal : Query.EndLocation;
+
+	FNavLocation ProjectedLegGoal;
+	if (NavData->ProjectPoint(LegGoal, ProjectedLegGoal, GetRouteProjectionExtent(*NavData), Query.QueryFilter, Query.Owner.Get()))
+	{
+		OutLegGoal = ProjectedLegGoal.Location;
+		return bHasLeg;
+	}
+
+	// leg ends where loaded navigation does, route continues as more of it streams in
+	if (bUseStreamingGoal)
+	{
+		if (!FindLoadedNavigationTowards(Query, LegGoal, OutLegGoal))
+		{
+			// nothing loaded ahead, wait where we are
+			OutLegGoal = Query.StartLocation;
+		}
+		return true;
+	}
+
+	PLAYERMOVETO_VLOG_LOCATION(GetGameplayTasksComponent(), LogGameplayTasks, Warning, LegGoal, 30.f, FColor::Orange, TEXT("%s> route leg end isn't on navigation, searching whole path"), *GetName());
+	return false;
+}
+
+bool FPlayerMoveToDriver::CanAdvanceRoute() const
+{
+	FPathFindingQuery Query;
+	if (!bUseStreamingGoal || !BuildPathfindingQuery(MoveRequest, Query))
+	{
+		return true;
+	}
+
+	// leg found from pawn's location has to get somewhere, otherwise loaded navigation ends here
+	int32 WaypointIndex = RouteWaypointIndex;
+	FVector LegGoal;
+	return !FindRouteLeg(Query, WaypointIndex, LegGoal) || FVector::Dist(LegGoal, Query.StartLocation) > PlayerMoveToCVars::StreamingProbeStep * 0.5f;
+}
+
+bool FPlayerMoveToDriver::GetRouteLegGoal(const FVector& From, const FVector& Goal, int32& InOutWaypointIndex, FVector& OutLegGoal) const
+{
+	// walk the route from the current waypoint, leg ends once it is long enough
+	FVector::FReal RemainingDistance = PlayerMoveToCVars::RouteLegDistance;
+	FVector Point = From;
+	for (; InOutWaypointIndex <= RouteWaypoints.Num(); InOutWaypointIndex++)
+	{
+		const FVector& NextPoint = RouteWaypoints.IsValidIndex(InOutWaypointIndex) ? RouteWaypoints[InOutWaypointIndex] : Goal;
+		const FVector::FReal Distance = FVector::Dist(Point, NextPoint);
+		if (Distance > RemainingDistance)
+		{
+			OutLegGoal = Point + (NextPoint - Point) * (RemainingDistance / Distance);
+			return true;
+		}
+
+		RemainingDistance -= Distance;
+		Point = NextPoint;
+	}
+
+	return false;
+}
+
+void FPlayerMoveToDriver::ApplyRouteLeg(FPathFindingQuery& Query)
+{
+	bOnFinalLeg = true;
+
+	int32 WaypointIndex = RouteWaypointIndex;
+	FVector LegGoal;
+	if (!FindRouteLeg(Query, WaypointIndex, LegGoal))
+	{
+		return;
+	}
+
+	PLAYERMOVETO_VLOG_SEGMENT(GetGameplayTasksComponent(), LogGameplayTasks, Log, Query.StartLocation, LegGoal, FColor::Cyan, TEXT("%s> route leg"), *GetName());
+
+	// legs end wherever the search got, the route carries on from there
+	Query.EndLocation = LegGoal;
+	Query.SetAllowPartialPaths(true);
+	RouteWaypointIndex = WaypointIndex;
+	bOnFinalLeg = false;
+}
+
+void FPlayerMoveToDriver::StartRouteUpdates()
+{
+	UWorld* World = GetWorld();
+	if (!bOnFinalLeg && World && !World->GetTimerManager().IsTimerActive(RouteTimerHandle))
+	{
+		World->GetTimerManager().SetTimer(RouteTimerHandle,
+			FTimerDelegate::CreateWeakLambda(OwnerTask, [this]() { UpdateRoute(); }), FMath::Max(0.01f, PlayerMoveToCVars::FollowInterval), true);
+	}
+}
+
+void FPlayerMoveToDriver::UpdateRoute()
+{
+	if (bOnFinalLeg)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(RouteTimerHandle);
+		}
+		return;
+	}
+
+	if (bHoldingAtRouteEnd)
+	{
+		if (CanAdvanceRoute())
+		{
+			PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> more navigation loaded, continuing route"), *GetName());
+			ConditionalPerformMove();
+		}
+		return;
+	}
+
+	if (OwnerController == nullptr || !Path.IsValid() || !Path->IsValid() || !Path->IsUpToDate() || PathFollowingComp == nullptr || PathFollowingComp->GetPath() != Path
+		|| PathFollowingComp->GetStatus() != EPathFollowingStatus::Moving || IsWaitingForPath())
+	{
+		return;
+	}
+
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	const FVector LegEnd = PathPoints.Last().Location;
+	if (FVector::Dist(OwnerController->GetNavAgentLocation(), LegEnd) > PlayerMoveToCVars::RouteRefineDistance || OwnerController->ShouldPostponePathUpdates())
+	{
+		return;
+	}
+
+	PLAYERMOVETO_SCOPE(RouteLeg);
+
+	FPathFindingQuery Query;
+	if (!BuildPathfindingQuery(MoveRequest, Query))
+	{
+		return;
+	}
+
+	// search next leg from the end of the followed one
+	const int32 PrevWaypointIndex = RouteWaypointIndex;
+	Query.StartLocation = LegEnd;
+	ApplyRouteLeg(Query);
+
+	if (!bOnFinalLeg && FVector::Dist(Query.EndLocation, LegEnd) <= PlayerMoveToCVars::StreamingProbeStep * 0.5f)
+	{
+		// no more navigation loaded past the end of the followed path
+		RouteWaypointIndex = PrevWaypointIndex;
+		return;
+	}
+
+	FNavPathSharedPtr LegPath;
+	FindPathForMoveRequest(MoveRequest, Query, LegPath);
+	if (!LegPath.IsValid() || LegPath->GetPathPoints().Num() < 2 || (bOnFinalLeg && LegPath->IsPartial() && !MoveRequest.IsUsingPartialPaths()))
+	{
+		// try again later, pawn requests the leg itself if it reaches the end first
+		RouteWaypointIndex = PrevWaypointIndex;
+		bOnFinalLeg = false;
+		return;
+	}
+
+	// points pawn already passed are dropped, path doesn't grow with trip length
+	const int32 CurrentIndex = FMath::Clamp(PathFollowingComp->GetCurrentPathIndex(), 0, PathPoints.Num() - 1);
+	TArray<FNavPathPoint> NewPoints(PathPoints.GetData() + CurrentIndex, PathPoints.Num() - CurrentIndex);
+	NewPoints.Append(LegPath->GetPathPoints().GetData() + 1, LegPath->GetPathPoints().Num() - 1);
+	UpdatePathInPlace(MoveTemp(NewPoints), LegPath.Get(), ENavPathUpdateType::GoalMoved, CurrentIndex, PathPoints.Num() - 1);
+}
+
+void FPlayerMoveToDriver::StartGoalTracking()
+{
+	UWorld* World = GetWorld();
+	if (MoveRequest.IsMoveToActorRequest() && World && !World->GetTimerManager().IsTimerActive(GoalTrackingTimerHandle))
+	{
+		World->GetTimerManager().SetTimer(GoalTrackingTimerHandle,
+			FTimerDelegate::CreateWeakLambda(OwnerTask, [this]() { UpdateGoalTracking(); }), FMath::Max(0.01f, PlayerMoveToCVars::FollowInterval), true);
+	}
+}
+
+void FPlayerMoveToDriver::UpdateGoalTracking()
+{
+	PLAYERMOVETO_SCOPE(GoalTracking);
+
+	if (!IsTrackingGoal())
+	{
+		UpdateGoalObservation();
+		return;
+	}
+
+	if (MoveRequest.GetGoalActor() == nullptr)
+	{
+		PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal actor is gone, aborting!"), *GetName());
+		FinishMoveTask(EPathFollowingResult::Invalid);
+		return;
+	}
+
+	const APawn* Pawn = OwnerController ? OwnerController->GetPawn() : nullptr;
+	if (Pawn == nullptr || PathFollowingComp == nullptr || IsWaitingForPath() || MoveRetryHandle.IsValid())
+	{
+		return;
+	}
+
+	const FVector GoalLocation = GetMoveGoalLocation(MoveRequest);
+	if (bHoldingAtGoal)
+	{
+		// never search while goal is still within reach
+		if (PathFollowingComp->HasReached(MoveRequest))
+		{
+			return;
+		}
+	}
+	else if (!Path.IsValid() || FVector::DistSquared(ObservedGoalLocation, GoalLocation) <= FMath::Square(GetGoalObservationTolerance(GoalLocation)))
+	{
+		return;
+	}
+
+	if (CanRepathForGoal())
+	{
+		LastGoalRepathTime = GetWorld()->GetTimeSeconds();
+		RetargetPath(GoalLocation);
+	}
+}
+
+void FPlayerMoveToDriver::UpdateGoalObservation()
+{
+	const AActor* GoalActor = MoveRequest.GetGoalActor();
+	ANavigationData* NavData = Path.IsValid() ? Path->GetNavigationDataUsed() : nullptr;
+	if (GoalActor == nullptr || NavData == nullptr || !MoveRequestID.IsValid() || Path->IsWaitingForRepath())
+	{
+		return;
+	}
+
+	const FVector GoalLocation = GetMoveGoalLocation(MoveRequest);
+	if (FVector::DistSquared(ObservedGoalLocation, GoalLocation) <= FMath::Square(GetGoalObservationTolerance(GoalLocation)) || !CanRepathForGoal())
+	{
+		return;
+	}
+
+	PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal actor moved, repathing"), *GetName());
+	LastGoalRepathTime = GetWorld()->GetTimeSeconds();
+	NavData->RequestRePath(Path, ENavPathUpdateType::GoalMoved);
+}
+
+float FPlayerMoveToDriver::GetGoalObservationTolerance(const FVector& GoalLocation) const
+{
+	const APawn* Pawn = OwnerController ? OwnerController->GetPawn() : nullptr;
+	const float MinTolerance = FMath::Max(0.f, GoalObservation.MinTolerance);
+	const float MaxTolerance = FMath::Max(MinTolerance, GoalObservation.MaxTolerance);
+	const float Distance = Pawn ? FVector::Dist(OwnerController->GetNavAgentLocation(), GoalLocation) : 0.f;
+	return FMath::Clamp(Distance * GoalObservation.DistanceScale, MinTolerance, MaxTolerance);
+}
+
+bool FPlayerMoveToDriver::CanRepathForGoal() const
+{
+	return GoalObservation.MaxRepathRate <= 0.f || GetWorld()->GetTimeSeconds() - LastGoalRepathTime >= 1.0 / GoalObservation.MaxRepathRate;
+}
+
+void FPlayerMoveToDriver::RetargetPath(const FVector& GoalLocation)
+{
+	const FVector PawnLocation = OwnerController->GetNavAgentLocation();
+	ANavigationData* NavData = Path.IsValid() ? Path->GetNavigationDataUsed() : nullptr;
+
+	if (NavData && NumPathExtensions < PlayerMoveToCVars::FollowMaxExtensions)
+	{
+		const bool bFollowingPath = IsFollowingObservedPath();
+		const bool bStraightLine = HasNavigationLineOfSight(*NavData, PawnLocation, GoalLocation);
+		if (bStraightLine || (bFollowingPath && HasNavigationLineOfSight(*NavData, Path->GetEndLocation(), GoalLocation)))
+		{
+			// goal is in sight so the search is short, it gives the new part of the path its corridor
+			FPathFindingQuery Query;
+			FNavPathSharedPtr SearchedPath;
+			if (BuildPathfindingQuery(MoveRequest, Query))
+			{
+				Query.StartLocation = bStraightLine ? PawnLocation : Path->GetEndLocation();
+				Query.EndLocation = GoalLocation;
+				Query.SetAllowPartialPaths(false);
+				FindPathForMoveRequest(MoveRequest, Query, SearchedPath);
+			}
+
+			if (SearchedPath.IsValid() && SearchedPath->GetPathPoints().Num() >= 2 && !SearchedPath->IsPartial())
+			{
+				NumPathExtensions++;
+				bHoldingAtGoal = false;
+
+				if (bFollowingPath && bStraightLine)
+				{
+					PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal moved, following it in straight line"), *GetName());
+					UpdatePathInPlace(TArray<FNavPathPoint>(SearchedPath->GetPathPoints()), SearchedPath.Get(), ENavPathUpdateType::GoalMoved);
+					return;
+				}
+
+				if (bFollowingPath)
+				{
+					// extend followed path towards new goal location, points pawn already passed are dropped
+					PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal moved, extending path"), *GetName());
+					const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+					const int32 CurrentIndex = FMath::Clamp(PathFollowingComp->GetCurrentPathIndex(), 0, PathPoints.Num() - 1);
+					TArray<FNavPathPoint> NewPoints(PathPoints.GetData() + CurrentIndex, PathPoints.Num() - CurrentIndex);
+					NewPoints.Append(SearchedPath->GetPathPoints().GetData() + 1, SearchedPath->GetPathPoints().Num() - 1);
+					UpdatePathInPlace(MoveTemp(NewPoints), SearchedPath.Get(), ENavPathUpdateType::GoalMoved, CurrentIndex, PathPoints.Num() - 1);
+					return;
+				}
+
+				// request holding at goal already finished, a new one is needed to start moving again
+				PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal moved, following it in straight line"), *GetName());
+				ResetObservers();
+				if (RequestMoveOnPath(SearchedPath))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	PLAYERMOVETO_VLOG(GetGameplayTasksComponent(), LogGameplayTasks, Log, TEXT("%s> goal moved out of reach, searching new path"), *GetName());
+	PerformMove();
+}
+
+bool FPlayerMoveToDriver::IsFollowingObservedPath() const
+{
+	return PathFollowingComp && Path.IsValid() && PathFollowingComp->GetPath() == Path && MoveRequestID.IsEquivalent(PathFollowingComp->GetCurrentRequestId())
+		&& PathFollowingComp->GetStatus() == EPathFollowingStatus::Moving;
+}
+
+bool FPlayerMoveToDriver::HasNavigationLineOfSight(const ANavigationData& NavData, const FVector& Start, const FVector& End) const
+{
+	const FSharedConstNavQueryFilter NavFilter = UNavigationQueryFilter::GetQueryFilter(NavData, OwnerTask, MoveRequest.GetNavigationFilter());
+	FVector HitLocation;
+	return !NavData.Raycast(Start, End, HitLocation, NavFilter, OwnerController);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToNavReadySubsystem.h"
+
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "NavigationSystem.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToNavReadySubsystem)
+
+namespace PlayerMoveToCVars
+{
+	static float NavReadyPollInterval = 0.5f;
+	FAutoConsoleVariableRef CVarNavReadyPollInterval(
+		TEXT("PlayerMoveTo.NavReady.PollInterval"),
+		NavReadyPollInterval,
+		TEXT("Interval of fallback poll waking moves that wait for navigation, in case they were postponed for a reason other than navigation being built. 0 = wake only on navigation generation finishing"),
+		ECVF_Default);
+}
+
+UPlayerMoveToNavReadySubsystem* UPlayerMoveToNavReadySubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPlayerMoveToNavReadySubsystem>() : nullptr;
+}
+
+FDelegateHandle UPlayerMoveToNavReadySubsystem::WaitForNavigation(const FSimpleDelegate& Delegate)
+{
+	BindToNavigationSystem();
+
+	const FDelegateHandle Handle = OnNavigationReady.Add(Delegate);
+	UpdatePollTimer();
+	return Handle;
+}
+
+void UPlayerMoveToNavReadySubsystem::StopWaiting(FDelegateHandle Handle)
+{
+	OnNavigationReady.Remove(Handle);
+	UpdatePollTimer();
+}
+
+void UPlayerMoveToNavReadySubsystem::NotifyNavigationReady()
+{
+	// moves that still can't path wait for the next wake up
+	const FSimpleMulticastDelegate WaitingMoves = OnNavigationReady;
+	OnNavigationReady.Clear();
+
+	WaitingMoves.Broadcast();
+	UpdatePollTimer();
+}
+
+void UPlayerMoveToNavReadySubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = BoundNavSys.Get())
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UPlayerMoveToNavReadySubsystem::OnNavigationGenerationFinished);
+	}
+	BoundNavSys.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PollTimerHandle);
+	}
+	OnNavigationReady.Clear();
+
+	Super::Deinitialize();
+}
+
+bool UPlayerMoveToNavReadySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPlayerMoveToNavReadySubsystem::BindToNavigationSystem()
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys == nullptr || NavSys == BoundNavSys.Get())
+	{
+		return;
+	}
+
+	NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UPlayerMoveToNavReadySubsystem::OnNavigationGenerationFinished);
+	BoundNavSys = NavSys;
+}
+
+void UPlayerMoveToNavReadySubsystem::UpdatePollTimer()
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if (!HasWaitingMoves() || PlayerMoveToCVars::NavReadyPollInterval <= 0.f)
+	{
+		TimerManager.ClearTimer(PollTimerHandle);
+	}
+	else if (!TimerManager.IsTimerActive(PollTimerHandle))
+	{
+		TimerManager.SetTimer(PollTimerHandle, FTimerDelegate::CreateUObject(this, &UPlayerMoveToNavReadySubsystem::NotifyNavigationReady),
+			PlayerMoveToCVars::NavReadyPollInterval, true);
+	}
+}
+
+void UPlayerMoveToNavReadySubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	NotifyNavigationReady();
+}
@@ -0,0 +1,100 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToNetTypes.h"
+
+#include "NavigationData.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToNetTypes)
+
+namespace PlayerMoveToCVars
+{
+	static int32 PredictionMaxPathPoints = 64;
+	FAutoConsoleVariableRef CVarPredictionMaxPathPoints(
+		TEXT("PlayerMoveTo.Prediction.MaxPathPoints"),
+		PredictionMaxPathPoints,
+		TEXT("Number of points of predicted paths sent to and validated by the server, the rest of longer paths isn't validated"),
+		ECVF_Default);
+}
+
+FPlayerMovePathDigest::FPlayerMovePathDigest(uint32 InMoveId, const FNavigationPath& Path, TSubclassOf<UNavigationQueryFilter> InFilterClass)
+	: MoveId(InMoveId)
+	, FilterClass(InFilterClass)
+	, bPartial(Path.IsPartial())
+{
+	const int32 NumPoints = FMath::Min(Path.GetPathPoints().Num(), GetMaxPathPoints());
+	PathPoints.Reserve(NumPoints);
+	for (int32 Index = 0; Index < NumPoints; Index++)
+	{
+		PathPoints.Add(Path.GetPathPoints()[Index].Location);
+	}
+}
+
+int32 FPlayerMovePathDigest::GetMaxPathPoints()
+{
+	return FMath::Max(2, PlayerMoveToCVars::PredictionMaxPathPoints);
+}
+
+namespace PlayerMoveToNetTypes
+{
+	/** upper bound of received point count, anything above is a corrupt packet */
+	static constexpr int32 MaxNetPathPoints = 1024;
+
+	static void SerializeDelta(FArchive& Ar, int32& Value)
+	{
+		// zigzag encoding keeps small negative deltas small
+		uint32 Encoded = ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		Value = (int32)(Encoded >> 1) ^ -(int32)(Encoded & 1);
+	}
+}
+
+bool FPlayerMoveNetPath::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar.SerializeIntPacked(MoveId);
+
+	// first point is sent relative to the window start, both are small
+	uint32 PackedStartIndex = (uint32)FMath::Max(0, StartIndex);
+	Ar.SerializeIntPacked(PackedStartIndex);
+	StartIndex = (int32)PackedStartIndex;
+
+	uint32 PackedFirstPointOffset = (uint32)FMath::Max(0, FirstPointIndex - StartIndex);
+	Ar.SerializeIntPacked(PackedFirstPointOffset);
+	FirstPointIndex = StartIndex + (int32)PackedFirstPointOffset;
+
+	uint32 NumPoints = PathPoints.Num();
+	Ar.SerializeIntPacked(NumPoints);
+	if (Ar.IsLoading())
+	{
+		if (NumPoints > PlayerMoveToNetTypes::MaxNetPathPoints || PackedStartIndex > (uint32)MAX_int32 / 2 || PackedFirstPointOffset > PlayerMoveToNetTypes::MaxNetPathPoints)
+		{
+			bOutSuccess = false;
+			return false;
+		}
+		PathPoints.SetNum(NumPoints);
+	}
+
+	FIntVector Previous = FIntVector::ZeroValue;
+	for (FVector& PathPoint : PathPoints)
+	{
+		const FVector Quantized = Quantize(PathPoint);
+		FIntVector Delta(FIntVector((int32)Quantized.X, (int32)Quantized.Y, (int32)Quantized.Z) - Previous);
+		PlayerMoveToNetTypes::SerializeDelta(Ar, Delta.X);
+		PlayerMoveToNetTypes::SerializeDelta(Ar, Delta.Y);
+		PlayerMoveToNetTypes::SerializeDelta(Ar, Delta.Z);
+
+		Previous += Delta;
+		if (Ar.IsLoading())
+		{
+			PathPoint = FVector(Previous);
+		}
+	}
+
+	uint8 bPartialBit = bPartial ? 1 : 0;
+	Ar.SerializeBits(&bPartialBit, 1);
+	bPartial = bPartialBit != 0;
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
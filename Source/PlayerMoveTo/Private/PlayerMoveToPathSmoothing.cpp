@@ -0,0 +1,200 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToPathSmoothing.h"
+#include "PlayerMoveToStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+#include "NavigationData.h"
+
+namespace PlayerMoveToCVars
+{
+	static bool bEnablePathSmoothing = false;
+	FAutoConsoleVariableRef CVarEnablePathSmoothing(
+		TEXT("PlayerMoveTo.Smoothing.Enable"),
+		bEnablePathSmoothing,
+		TEXT("Smooth paths found for player moves: drop corners that can be cut and round the remaining ones"),
+		ECVF_Default);
+
+	static float SmoothingCornerRadius = 50.f;
+	FAutoConsoleVariableRef CVarSmoothingCornerRadius(
+		TEXT("PlayerMoveTo.Smoothing.CornerRadius"),
+		SmoothingCornerRadius,
+		TEXT("Distance from a corner its rounding starts at, limited to half of the adjacent segments"),
+		ECVF_Default);
+
+	static int32 SmoothingPointsPerCorner = 4;
+	FAutoConsoleVariableRef CVarSmoothingPointsPerCorner(
+		TEXT("PlayerMoveTo.Smoothing.PointsPerCorner"),
+		SmoothingPointsPerCorner,
+		TEXT("Points a rounded corner is made of, lowered when the path would get more than PlayerMoveTo.Smoothing.MaxPoints"),
+		ECVF_Default);
+
+	static int32 SmoothingMaxPoints = 64;
+	FAutoConsoleVariableRef CVarSmoothingMaxPoints(
+		TEXT("PlayerMoveTo.Smoothing.MaxPoints"),
+		SmoothingMaxPoints,
+		TEXT("Maximum number of points of a smoothed path"),
+		ECVF_Default);
+}
+
+namespace PlayerMoveToPathSmoothing
+{
+	/** navigation links have to be walked between their exact ends */
+	static bool IsLinkPoint(const FNavPathPoint& PathPoint)
+	{
+		return PathPoint.CustomLinkId != 0 || FNavMeshNodeFlags(PathPoint.Flags).IsNavLink();
+	}
+
+	static bool CanMovePoint(const TArray<FNavPathPoint>& PathPoints, int32 Index)
+	{
+		return Index > 0 && Index < PathPoints.Num() - 1 && !IsLinkPoint(PathPoints[Index]) && !IsLinkPoint(PathPoints[Index - 1]);
+	}
+
+	/** drop every other corner that can be cut, all of them are tested in a single batch */
+	static void RemoveRedundantCorners(TArray<FNavPathPoint>& PathPoints, const ANavigationData& NavData, FSharedConstNavQueryFilter NavFilter, const UObject* Querier)
+	{
+		TArray<int32> Candidates;
+		TArray<FNavigationRaycastWork> Workload;
+		for (int32 Index = 1; Index < PathPoints.Num() - 1; Index += 2)
+		{
+			if (CanMovePoint(PathPoints, Index))
+			{
+				Candidates.Add(Index);
+				Workload.Emplace(PathPoints[Index - 1].Location, PathPoints[Index + 1].Location);
+			}
+		}
+
+		if (Workload.Num() == 0)
+		{
+			return;
+		}
+
+		NavData.BatchRaycast(Workload, NavFilter, Querier);
+
+		for (int32 WorkIndex = Workload.Num() - 1; WorkIndex >= 0; WorkIndex--)
+		{
+			if (!Workload[WorkIndex].bDidHit)
+			{
+				PathPoints.RemoveAt(Candidates[WorkIndex]);
+			}
+		}
+	}
+
+	/** Evaluate quadratic bezier through P0, P1, P2 at NumSamples evenly spaced parameters, including both ends */
+	static void EvaluateCorner(const FVector& P0, const FVector& P1, const FVector& P2, int32 NumSamples, TArray<FVector>& OutPoints)
+	{
+		const VectorRegister4Double Control0 = VectorLoadFloat3_W0(&P0.X);
+		const VectorRegister4Double Control1 = VectorLoadFloat3_W0(&P1.X);
+		const VectorRegister4Double Control2 = VectorLoadFloat3_W0(&P2.X);
+
+		const int32 FirstPoint = OutPoints.AddUninitialized(NumSamples);
+		for (int32 Sample = 0; Sample < NumSamples; Sample++)
+		{
+			const double T = (double)Sample / (NumSamples - 1);
+			const double InvT = 1.0 - T;
+
+			VectorRegister4Double Point = VectorMultiply(Control0, VectorSetFloat1(InvT * InvT));
+			Point = VectorMultiplyAdd(Control1, VectorSetFloat1(2.0 * InvT * T), Point);
+			Point = VectorMultiplyAdd(Control2, VectorSetFloat1(T * T), Point);
+			VectorStoreFloat3(Point, &OutPoints[FirstPoint + Sample].X);
+		}
+	}
+
+	/** replace corners with bezier curves where the cut stays on navigation */
+	static void RoundCorners(TArray<FNavPathPoint>& PathPoints, const ANavigationData& NavData, FSharedConstNavQueryFilter NavFilter, const UObject* Querier)
+	{
+		const int32 NumCorners = PathPoints.Num() - 2;
+		const int32 PointBudget = FMath::Max(0, PlayerMoveToCVars::SmoothingMaxPoints - PathPoints.Num());
+		const int32 NumSamples = FMath::Min(PlayerMoveToCVars::SmoothingPointsPerCorner, 1 + PointBudget / FMath::Max(1, NumCorners));
+		if (NumCorners <= 0 || NumSamples < 2 || PlayerMoveToCVars::SmoothingCornerRadius <= 0.f)
+		{
+			return;
+		}
+
+		// ends of every rounded corner, chord between them has to stay on navigation
+		TArray<int32> Corners;
+		TArray<FVector> CornerEnds;
+		TArray<FNavigationRaycastWork> Workload;
+		for (int32 Index = 1; Index < PathPoints.Num() - 1; Index++)
+		{
+			if (!CanMovePoint(PathPoints, Index))
+			{
+				continue;
+			}
+
+			const FVector& Prev = PathPoints[Index - 1].Location;
+			const FVector& Corner = PathPoints[Index].Location;
+			const FVector& Next = PathPoints[Index + 1].Location;
+			const float InDistance = FMath::Min(PlayerMoveToCVars::SmoothingCornerRadius, FVector::Dist(Prev, Corner) * 0.5f);
+			const float OutDistance = FMath::Min(PlayerMoveToCVars::SmoothingCornerRadius, FVector::Dist(Corner, Next) * 0.5f);
+			const FVector Start = Corner + (Prev - Corner).GetSafeNormal() * InDistance;
+			const FVector End = Corner + (Next - Corner).GetSafeNormal() * OutDistance;
+
+			Corners.Add(Index);
+			CornerEnds.Add(Start);
+			CornerEnds.Add(End);
+			Workload.Emplace(Start, End);
+		}
+
+		if (Workload.Num() == 0)
+		{
+			return;
+		}
+
+		NavData.BatchRaycast(Workload, NavFilter, Querier);
+
+		TArray<FNavPathPoint> SmoothedPoints;
+		SmoothedPoints.Reserve(PathPoints.Num() + Corners.Num() * NumSamples);
+		TArray<FVector> CurvePoints;
+		int32 WorkIndex = 0;
+		for (int32 Index = 0; Index < PathPoints.Num(); Index++)
+		{
+			const bool bRoundCorner = WorkIndex < Corners.Num() && Corners[WorkIndex] == Index && !Workload[WorkIndex].bDidHit;
+			if (bRoundCorner)
+			{
+				CurvePoints.Reset();
+				EvaluateCorner(CornerEnds[WorkIndex * 2], PathPoints[Index].Location, CornerEnds[WorkIndex * 2 + 1], NumSamples, CurvePoints);
+				for (const FVector& CurvePoint : CurvePoints)
+				{
+					// curve stays close to the corner, its node is good enough for path following
+					FNavPathPoint& SmoothedPoint = SmoothedPoints.Add_GetRef(PathPoints[Index]);
+					SmoothedPoint.Location = CurvePoint;
+				}
+			}
+			else
+			{
+				SmoothedPoints.Add(PathPoints[Index]);
+			}
+
+			if (WorkIndex < Corners.Num() && Corners[WorkIndex] == Index)
+			{
+				WorkIndex++;
+			}
+		}
+
+		PathPoints = MoveTemp(SmoothedPoints);
+	}
+
+	bool IsEnabled()
+	{
+		return PlayerMoveToCVars::bEnablePathSmoothing;
+	}
+
+	void SmoothPath(FNavigationPath& InPath, const ANavigationData& NavData, const UObject* Querier)
+	{
+		PLAYERMOVETO_SCOPE(PathSmoothing);
+
+		TArray<FNavPathPoint>& PathPoints = InPath.GetPathPoints();
+		if (PathPoints.Num() < 3)
+		{
+			return;
+		}
+
+		// cuts have to hold for the filter the path was found with, not just any navigation
+		const FSharedConstNavQueryFilter NavFilter = InPath.GetFilter().IsValid() ? InPath.GetFilter() : NavData.GetDefaultQueryFilter();
+		RemoveRedundantCorners(PathPoints, NavData, NavFilter, Querier);
+		RoundCorners(PathPoints, NavData, NavFilter, Querier);
+	}
+}
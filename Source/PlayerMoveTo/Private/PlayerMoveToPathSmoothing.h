@@ -0,0 +1,21 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FNavigationPath;
+class ANavigationData;
+
+/**
+ * Optional post-process of found paths, enabled by PlayerMoveTo.Smoothing cvars
+ * Corners that navigation allows to cut are dropped and the remaining ones are rounded, the point count stays bounded
+ */
+namespace PlayerMoveToPathSmoothing
+{
+	/** true if found paths should be smoothed */
+	bool IsEnabled();
+
+	/** smooth points of InPath in place, corners are only cut where raycasts on NavData with the path's filter stay on navigation */
+	void SmoothPath(FNavigationPath& InPath, const ANavigationData& NavData, const UObject* Querier);
+}
@@ -0,0 +1,174 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToQuerySubsystem.h"
+#include "PlayerMoveToStats.h"
+
+#include "Engine/World.h"
+#include "NavigationData.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToQuerySubsystem)
+
+UPlayerMoveToQuerySubsystem::UPlayerMoveToQuerySubsystem()
+	: NextQueryID(INVALID_NAVQUERYID + 1)
+	, bCanRunQueries(false)
+{
+}
+
+UPlayerMoveToQuerySubsystem* UPlayerMoveToQuerySubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPlayerMoveToQuerySubsystem>() : nullptr;
+}
+
+uint32 UPlayerMoveToQuerySubsystem::FindPathAsync(const FPathFindingQuery& Query, const FNavPathQueryDelegate& Delegate)
+{
+	if (!Query.NavData.IsValid())
+	{
+		return INVALID_NAVQUERYID;
+	}
+
+	const uint32 QueryID = NextQueryID++;
+	if (NextQueryID == INVALID_NAVQUERYID)
+	{
+		NextQueryID++;
+	}
+
+	FWorkerQuery WorkerQuery;
+	WorkerQuery.QueryID = QueryID;
+	WorkerQuery.Query = Query;
+	WorkerQuery.OnDoneDelegate = Delegate;
+
+	if (bCanRunQueries)
+	{
+		LaunchQuery(WorkerQuery);
+		RunningQueries.Add(MoveTemp(WorkerQuery));
+	}
+	else
+	{
+		PendingQueries.Add(MoveTemp(WorkerQuery));
+	}
+
+	return QueryID;
+}
+
+void UPlayerMoveToQuerySubsystem::AbortQuery(uint32 QueryID)
+{
+	PendingQueries.RemoveAll([QueryID](const FWorkerQuery& WorkerQuery) { return WorkerQuery.QueryID == QueryID; });
+
+	for (FWorkerQuery& WorkerQuery : RunningQueries)
+	{
+		if (WorkerQuery.QueryID == QueryID)
+		{
+			WorkerQuery.OnDoneDelegate.Unbind();
+		}
+	}
+}
+
+void UPlayerMoveToQuerySubsystem::JoinQueries()
+{
+	// delegates can start new moves, those wait for next navigation tick
+	TArray<FWorkerQuery> FinishedQueries = MoveTemp(RunningQueries);
+	RunningQueries.Reset();
+
+	{
+		PLAYERMOVETO_SCOPE(WorkerJoin);
+		for (FWorkerQuery& WorkerQuery : FinishedQueries)
+		{
+			WaitForQuery(WorkerQuery);
+		}
+	}
+
+	for (FWorkerQuery& WorkerQuery : FinishedQueries)
+	{
+		const FPathFindingResult& Result = WorkerQuery.Task.GetResult();
+		WorkerQuery.OnDoneDelegate.ExecuteIfBound(WorkerQuery.QueryID, Result.Result, Result.Path);
+	}
+}
+
+void UPlayerMoveToQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	bCanRunQueries = false;
+	JoinQueries();
+}
+
+TStatId UPlayerMoveToQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPlayerMoveToQuerySubsystem, STATGROUP_Tickables);
+}
+
+void UPlayerMoveToQuerySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UPlayerMoveToQuerySubsystem::OnWorldPreActorTick);
+}
+
+void UPlayerMoveToQuerySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+
+	PendingQueries.Reset();
+	for (FWorkerQuery& WorkerQuery : RunningQueries)
+	{
+		WaitForQuery(WorkerQuery);
+	}
+	RunningQueries.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPlayerMoveToQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPlayerMoveToQuerySubsystem::OnWorldPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	// navigation system ticked, data stays untouched until the next world tick
+	bCanRunQueries = true;
+
+	for (FWorkerQuery& WorkerQuery : PendingQueries)
+	{
+		LaunchQuery(WorkerQuery);
+	}
+	RunningQueries.Append(MoveTemp(PendingQueries));
+	PendingQueries.Reset();
+}
+
+void UPlayerMoveToQuerySubsystem::LaunchQuery(FWorkerQuery& WorkerQuery)
+{
+	const ANavigationData* NavData = WorkerQuery.Query.NavData.Get();
+	if (NavData == nullptr)
+	{
+		WorkerQuery.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, []() { return FPathFindingResult(ENavigationQueryResult::Error); });
+		return;
+	}
+
+	// same lock the engine's batched queries take, its counter isn't thread safe so it is taken and released on game thread
+	NavData->BeginBatchQuery();
+	WorkerQuery.LockedNavData = NavData;
+
+	WorkerQuery.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [NavData, Query = WorkerQuery.Query]()
+	{
+		PLAYERMOVETO_SCOPE(WorkerPathSearch);
+		return NavData->FindPath(Query.NavAgentProperties, Query);
+	});
+}
+
+void UPlayerMoveToQuerySubsystem::WaitForQuery(FWorkerQuery& WorkerQuery)
+{
+	WorkerQuery.Task.Wait();
+
+	if (const ANavigationData* NavData = WorkerQuery.LockedNavData.Get())
+	{
+		NavData->FinishBatchQuery();
+	}
+	WorkerQuery.LockedNavData.Reset();
+}
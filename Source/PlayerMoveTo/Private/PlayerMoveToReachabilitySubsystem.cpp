@@ -0,0 +1,235 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToReachabilitySubsystem.h"
+#include "PlayerMoveToDriver.h"
+#include "PlayerMoveToStats.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "NavigationData.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToReachabilitySubsystem)
+
+namespace PlayerMoveToCVars
+{
+	static float ReachabilityCacheDuration = 1.f;
+	FAutoConsoleVariableRef CVarReachabilityCacheDuration(
+		TEXT("PlayerMoveTo.Reachability.CacheDuration"),
+		ReachabilityCacheDuration,
+		TEXT("Seconds a reachability result is reused for, navmesh changes under it are not detected. 0 = disabled"),
+		ECVF_Default);
+
+	static int32 ReachabilityCacheMaxEntries = 256;
+	FAutoConsoleVariableRef CVarReachabilityCacheMaxEntries(
+		TEXT("PlayerMoveTo.Reachability.MaxEntries"),
+		ReachabilityCacheMaxEntries,
+		TEXT("Maximum number of cached reachability results per world, oldest are dropped first"),
+		ECVF_Default);
+
+	static bool bParallelReachability = true;
+	FAutoConsoleVariableRef CVarParallelReachability(
+		TEXT("PlayerMoveTo.Reachability.Parallel"),
+		bParallelReachability,
+		TEXT("Run tests of TestReachabilityBatch on worker threads"),
+		ECVF_Default);
+}
+
+UPlayerMoveToReachabilitySubsystem* UPlayerMoveToReachabilitySubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPlayerMoveToReachabilitySubsystem>() : nullptr;
+}
+
+FPlayerMoveReachability UPlayerMoveToReachabilitySubsystem::TestReachability(APlayerController* Controller, FVector GoalLocation,
+	AActor* GoalActor, EPlayerMoveReachabilityTest Test, TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	TArray<FVector> GoalLocations;
+	TArray<AActor*> GoalActors;
+	if (GoalActor)
+	{
+		GoalActors.Add(GoalActor);
+	}
+	else
+	{
+		GoalLocations.Add(GoalLocation);
+	}
+
+	return TestReachabilityBatch(Controller, GoalLocations, GoalActors, Test, FilterClass)[0];
+}
+
+TArray<FPlayerMoveReachability> UPlayerMoveToReachabilitySubsystem::TestReachabilityBatch(APlayerController* Controller,
+	const TArray<FVector>& GoalLocations, const TArray<AActor*>& GoalActors, EPlayerMoveReachabilityTest Test,
+	TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	PLAYERMOVETO_SCOPE(Reachability);
+
+	TArray<FPlayerMoveReachability> Results;
+	Results.SetNum(GoalLocations.Num() + GoalActors.Num());
+	if (Controller == nullptr)
+	{
+		return Results;
+	}
+
+	// build queries on game thread, served from cache when possible
+	TArray<int32> QueryOwners;
+	TArray<FPathFindingQuery> Queries;
+	TArray<FResultKey> QueryKeys;
+	for (int32 Index = 0; Index < Results.Num(); Index++)
+	{
+		FAIMoveRequest Request;
+		if (Index < GoalLocations.Num())
+		{
+			Request.SetGoalLocation(GoalLocations[Index]);
+		}
+		else if (GoalActors[Index - GoalLocations.Num()])
+		{
+			Request.SetGoalActor(GoalActors[Index - GoalLocations.Num()]);
+		}
+		else
+		{
+			continue;
+		}
+		Request.SetNavigationFilter(FilterClass);
+
+		FPathFindingQuery Query;
+		if (!FPlayerMoveToDriver::BuildPathfindingQuery(*Controller, Request, Controller, Query) || !Query.NavData.IsValid())
+		{
+			continue;
+		}
+		Query.SetAllowPartialPaths(false);
+
+		FResultKey Key;
+		Key.PathKey = FPlayerMovePathCacheKey(Query, Controller->GetNavAgentPropertiesRef(), FilterClass);
+		Key.Test = Test;
+		if (FindResult(Key, Results[Index]))
+		{
+			continue;
+		}
+
+		QueryOwners.Add(Index);
+		Queries.Add(Query);
+		QueryKeys.Add(Key);
+	}
+
+	// tests only read navigation data and the game thread is blocked until all of them are done
+	TArray<FPlayerMoveReachability> QueryResults;
+	QueryResults.SetNum(Queries.Num());
+	ParallelFor(Queries.Num(), [&Queries, &QueryResults, Test](int32 QueryIndex)
+	{
+		QueryResults[QueryIndex] = RunTest(Queries[QueryIndex], Test);
+	}, PlayerMoveToCVars::bParallelReachability ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	for (int32 QueryIndex = 0; QueryIndex < QueryResults.Num(); QueryIndex++)
+	{
+		Results[QueryOwners[QueryIndex]] = QueryResults[QueryIndex];
+		AddResult(QueryKeys[QueryIndex], QueryResults[QueryIndex]);
+	}
+
+	return Results;
+}
+
+FPlayerMoveReachability UPlayerMoveToReachabilitySubsystem::RunTest(const FPathFindingQuery& Query, EPlayerMoveReachabilityTest Test)
+{
+	FPlayerMoveReachability Result;
+	const ANavigationData* NavData = Query.NavData.Get();
+	if (NavData == nullptr)
+	{
+		return Result;
+	}
+
+	switch (Test)
+	{
+	case EPlayerMoveReachabilityTest::PathLength:
+		{
+			FVector::FReal PathLength = 0.f;
+			FVector::FReal PathCost = 0.f;
+			Result.bReachable = NavData->CalcPathLengthAndCost(Query.StartLocation, Query.EndLocation, PathLength, PathCost, Query.QueryFilter, Query.Owner.Get()) == ENavigationQueryResult::Success;
+			if (Result.bReachable)
+			{
+				Result.PathLength = PathLength;
+				Result.PathCost = PathCost;
+			}
+		}
+		break;
+	case EPlayerMoveReachabilityTest::Reachable:
+		Result.bReachable = NavData->TestPath(Query.NavAgentProperties, Query, nullptr);
+		break;
+	case EPlayerMoveReachabilityTest::Hierarchical:
+		Result.bReachable = NavData->TestHierarchicalPath(Query.NavAgentProperties, Query, nullptr);
+		break;
+	}
+
+	return Result;
+}
+
+bool UPlayerMoveToReachabilitySubsystem::FindResult(const FResultKey& Key, FPlayerMoveReachability& OutResult)
+{
+	if (PlayerMoveToCVars::ReachabilityCacheDuration <= 0.f)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FCachedResult* Entry = ResultCache.Find(Key);
+	if ((Entry == nullptr || Now - Entry->AddedTime > PlayerMoveToCVars::ReachabilityCacheDuration) && Key.Test != EPlayerMoveReachabilityTest::PathLength)
+	{
+		Entry = ResultCache.Find(FResultKey{ Key.PathKey, EPlayerMoveReachabilityTest::PathLength });
+	}
+
+	if (Entry == nullptr || Now - Entry->AddedTime > PlayerMoveToCVars::ReachabilityCacheDuration)
+	{
+		NumMisses++;
+		return false;
+	}
+
+	OutResult = Entry->Result;
+	NumHits++;
+	return true;
+}
+
+void UPlayerMoveToReachabilitySubsystem::AddResult(const FResultKey& Key, const FPlayerMoveReachability& Result)
+{
+	if (PlayerMoveToCVars::ReachabilityCacheDuration <= 0.f || !Key.PathKey.IsValid())
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!ResultCache.Contains(Key))
+	{
+		// expired entries first, then the oldest ones
+		for (auto It = ResultCache.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value().AddedTime > PlayerMoveToCVars::ReachabilityCacheDuration)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		while (ResultCache.Num() > 0 && ResultCache.Num() >= PlayerMoveToCVars::ReachabilityCacheMaxEntries)
+		{
+			FResultKey OldestKey;
+			double OldestTime = TNumericLimits<double>::Max();
+			for (const TPair<FResultKey, FCachedResult>& Pair : ResultCache)
+			{
+				if (Pair.Value.AddedTime < OldestTime)
+				{
+					OldestKey = Pair.Key;
+					OldestTime = Pair.Value.AddedTime;
+				}
+			}
+			ResultCache.Remove(OldestKey);
+		}
+	}
+
+	FCachedResult& Entry = ResultCache.FindOrAdd(Key);
+	Entry.Result = Result;
+	Entry.AddedTime = Now;
+}
+
+bool UPlayerMoveToReachabilitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+/**
+ * Stats shown by "stat PlayerMoveTo", phases of a player move also show up as Unreal Insights trace scopes
+ * Defined in PlayerMoveTo.cpp
+ */
+DECLARE_STATS_GROUP(TEXT("PlayerMoveTo"), STATGROUP_PlayerMoveTo, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Perform Move"), STAT_PlayerMoveTo_PerformMove, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Goal Projection"), STAT_PlayerMoveTo_GoalProjection, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Query Building"), STAT_PlayerMoveTo_QueryBuilding, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Cache Lookup"), STAT_PlayerMoveTo_PathCacheLookup, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Search"), STAT_PlayerMoveTo_PathSearch, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Path Search"), STAT_PlayerMoveTo_BatchPathSearch, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Worker Path Search"), STAT_PlayerMoveTo_WorkerPathSearch, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Worker Join"), STAT_PlayerMoveTo_WorkerJoin, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Request Move"), STAT_PlayerMoveTo_RequestMove, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Repath"), STAT_PlayerMoveTo_Repath, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Repair"), STAT_PlayerMoveTo_PathRepair, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Goal Tracking"), STAT_PlayerMoveTo_GoalTracking, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Route Leg"), STAT_PlayerMoveTo_RouteLeg, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nearest Goal Selection"), STAT_PlayerMoveTo_NearestGoalSelection, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reachability"), STAT_PlayerMoveTo_Reachability, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Prediction Validation"), STAT_PlayerMoveTo_PredictionValidation, STATGROUP_PlayerMoveTo, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path Smoothing"), STAT_PlayerMoveTo_PathSmoothing, STATGROUP_PlayerMoveTo, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Tasks"), STAT_PlayerMoveTo_ActiveTasks, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Retries"), STAT_PlayerMoveTo_MoveRetries, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Repath Retries"), STAT_PlayerMoveTo_RepathRetries, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Task Pool Hits"), STAT_PlayerMoveTo_TaskPoolHits, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Task Pool Misses"), STAT_PlayerMoveTo_TaskPoolMisses, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Task Pool Free"), STAT_PlayerMoveTo_TaskPoolFree, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Predicted Paths Accepted"), STAT_PlayerMoveTo_PredictedPathsAccepted, STATGROUP_PlayerMoveTo, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Predicted Paths Rejected"), STAT_PlayerMoveTo_PredictedPathsRejected, STATGROUP_PlayerMoveTo, );
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(PlayerMoveTo_ActiveTasks);
+TRACE_DECLARE_INT_COUNTER_EXTERN(PlayerMoveTo_Retries);
+
+/** cycle stat and trace scope of a phase, Name is the part after STAT_PlayerMoveTo_ */
+#define PLAYERMOVETO_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_PlayerMoveTo_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlayerMoveTo_##Name)
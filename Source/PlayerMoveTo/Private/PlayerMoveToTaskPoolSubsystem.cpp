@@ -0,0 +1,82 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToTaskPoolSubsystem.h"
+#include "PlayerAITask_MoveTo.h"
+#include "PlayerMoveToStats.h"
+
+#include "Engine/World.h"
+#include "UObject/Package.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToTaskPoolSubsystem)
+
+namespace PlayerMoveToCVars
+{
+	static int32 TaskPoolSize = 0;
+	FAutoConsoleVariableRef CVarTaskPoolSize(
+		TEXT("PlayerMoveTo.TaskPool.Size"),
+		TaskPoolSize,
+		TEXT("Number of finished player move tasks kept for reuse per world, 0 = pooling disabled. Pooled tasks are reused once they ended, references to them must not be kept after they finished"),
+		ECVF_Default);
+}
+
+UPlayerMoveToTaskPoolSubsystem* UPlayerMoveToTaskPoolSubsystem::Get(const UWorld* World)
+{
+	return World && PlayerMoveToCVars::TaskPoolSize > 0 ? World->GetSubsystem<UPlayerMoveToTaskPoolSubsystem>() : nullptr;
+}
+
+UPlayerAITask_MoveTo* UPlayerMoveToTaskPoolSubsystem::AcquireTask()
+{
+	UPlayerAITask_MoveTo* Task = nullptr;
+	while (Task == nullptr && FreeTasks.Num() > 0)
+	{
+		Task = FreeTasks.Pop(false);
+	}
+
+	if (Task)
+	{
+		INC_DWORD_STAT(STAT_PlayerMoveTo_TaskPoolHits);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PlayerMoveTo_TaskPoolMisses);
+		Task = NewObject<UPlayerAITask_MoveTo>(GetTransientPackage(), UPlayerAITask_MoveTo::StaticClass());
+	}
+
+	Task->SetPool(this);
+	SET_DWORD_STAT(STAT_PlayerMoveTo_TaskPoolFree, FreeTasks.Num());
+	return Task;
+}
+
+void UPlayerMoveToTaskPoolSubsystem::ReleaseTask(UPlayerAITask_MoveTo* Task)
+{
+	if (Task == nullptr)
+	{
+		return;
+	}
+
+	Task->SetPool(nullptr);
+	if (FreeTasks.Num() < PlayerMoveToCVars::TaskPoolSize)
+	{
+		FreeTasks.Add(Task);
+	}
+	else
+	{
+		Task->MarkAsGarbage();
+	}
+	SET_DWORD_STAT(STAT_PlayerMoveTo_TaskPoolFree, FreeTasks.Num());
+}
+
+void UPlayerMoveToTaskPoolSubsystem::Deinitialize()
+{
+	FreeTasks.Reset();
+	SET_DWORD_STAT(STAT_PlayerMoveTo_TaskPoolFree, 0);
+
+	Super::Deinitialize();
+}
+
+bool UPlayerMoveToTaskPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
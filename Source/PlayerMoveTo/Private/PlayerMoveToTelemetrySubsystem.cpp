@@ -0,0 +1,77 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerMoveToTelemetrySubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerMoveToTelemetrySubsystem)
+
+namespace PlayerMoveToCVars
+{
+	static bool bEnableTelemetry = true;
+	FAutoConsoleVariableRef CVarEnableTelemetry(
+		TEXT("PlayerMoveTo.Telemetry.Enable"),
+		bEnableTelemetry,
+		TEXT("Record telemetry of finished player moves"),
+		ECVF_Default);
+
+	static int32 TelemetryBufferSize = 256;
+	FAutoConsoleVariableRef CVarTelemetryBufferSize(
+		TEXT("PlayerMoveTo.Telemetry.BufferSize"),
+		TelemetryBufferSize,
+		TEXT("Number of most recent player moves kept per world"),
+		ECVF_Default);
+}
+
+UPlayerMoveToTelemetrySubsystem* UPlayerMoveToTelemetrySubsystem::Get(const UWorld* World)
+{
+	return World && PlayerMoveToCVars::bEnableTelemetry ? World->GetSubsystem<UPlayerMoveToTelemetrySubsystem>() : nullptr;
+}
+
+void UPlayerMoveToTelemetrySubsystem::AddRecord(const FPlayerMoveTelemetry& Record)
+{
+	const int32 BufferSize = FMath::Max(1, PlayerMoveToCVars::TelemetryBufferSize);
+	if (Records.Num() > BufferSize || (Records.Num() < BufferSize && NextRecordIndex != 0))
+	{
+		// buffer was resized, put records back in order
+		Records = GetRecords();
+		Records.RemoveAt(0, FMath::Max(0, Records.Num() - BufferSize));
+		NextRecordIndex = 0;
+	}
+
+	if (Records.Num() < BufferSize)
+	{
+		Records.Add(Record);
+	}
+	else
+	{
+		Records[NextRecordIndex] = Record;
+		NextRecordIndex = (NextRecordIndex + 1) % BufferSize;
+	}
+
+	OnMoveRecorded.Broadcast(Record);
+}
+
+TArray<FPlayerMoveTelemetry> UPlayerMoveToTelemetrySubsystem::GetRecords() const
+{
+	TArray<FPlayerMoveTelemetry> OrderedRecords;
+	OrderedRecords.Reserve(Records.Num());
+	for (int32 Index = 0; Index < Records.Num(); Index++)
+	{
+		OrderedRecords.Add(Records[(NextRecordIndex + Index) % Records.Num()]);
+	}
+	return OrderedRecords;
+}
+
+void UPlayerMoveToTelemetrySubsystem::ClearRecords()
+{
+	Records.Reset();
+	NextRecordIndex = 0;
+}
+
+bool UPlayerMoveToTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
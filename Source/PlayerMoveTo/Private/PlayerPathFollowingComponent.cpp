@@ -0,0 +1,79 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PlayerPathFollowingComponent.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/NavMovementComponent.h"
+#include "NavigationData.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlayerPathFollowingComponent)
+
+UPlayerPathFollowingComponent::UPlayerPathFollowingComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, CornerLookAhead(60.f)
+	, ApproachDistance(150.f)
+	, MinApproachInputScale(0.3f)
+{
+}
+
+void UPlayerPathFollowingComponent::FollowPathSegment(float DeltaTime)
+{
+	// server ignores movement input of remote players, their moves are driven by the movement component as usual
+	APawn* Pawn = MovementComp ? Cast<APawn>(MovementComp->GetOwner()) : nullptr;
+	if (!Path.IsValid() || Pawn == nullptr || !Pawn->IsLocallyControlled())
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	const FVector CurrentLocation = MovementComp->GetActorFeetLocation();
+	FVector MoveDirection = (GetLookAheadLocation(CurrentLocation, CornerLookAhead) - CurrentLocation).GetSafeNormal();
+	if (MoveDirection.IsNearlyZero())
+	{
+		MoveDirection = (GetCurrentTargetLocation() - CurrentLocation).GetSafeNormal();
+	}
+
+	const bool bOnLastSegment = MoveSegmentEndIndex >= Path->GetPathPoints().Num() - 1;
+	const float InputScale = bOnLastSegment ? GetApproachInputScale(FVector::Dist(CurrentLocation, GetCurrentTargetLocation())) : 1.f;
+
+	// same input a player would give, movement component applies its own acceleration, prediction and root motion
+	Pawn->AddMovementInput(MoveDirection, InputScale);
+}
+
+FVector UPlayerPathFollowingComponent::GetLookAheadLocation(const FVector& Location, float Distance) const
+{
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	FVector SegmentStart = Location;
+	float RemainingDistance = Distance;
+	for (int32 PointIndex = MoveSegmentEndIndex; PathPoints.IsValidIndex(PointIndex); PointIndex++)
+	{
+		const FVector SegmentEnd = PathPoints[PointIndex].Location;
+		const float SegmentLength = FVector::Dist(SegmentStart, SegmentEnd);
+		if (SegmentLength >= RemainingDistance && SegmentLength > UE_KINDA_SMALL_NUMBER)
+		{
+			return FMath::Lerp(SegmentStart, SegmentEnd, RemainingDistance / SegmentLength);
+		}
+
+		// look ahead stops at custom navigation links, they have to be entered at their start
+		if (PathPoints[PointIndex].CustomLinkId != 0)
+		{
+			return SegmentEnd;
+		}
+
+		RemainingDistance -= SegmentLength;
+		SegmentStart = SegmentEnd;
+	}
+
+	return SegmentStart;
+}
+
+float UPlayerPathFollowingComponent::GetApproachInputScale(float DistanceToGoal) const
+{
+	if (ApproachDistance <= 0.f || DistanceToGoal >= ApproachDistance)
+	{
+		return 1.f;
+	}
+
+	return FMath::Max(MinApproachInputScale, DistanceToGoal / ApproachDistance);
+}
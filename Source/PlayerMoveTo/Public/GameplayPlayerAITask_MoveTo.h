@@ -8,14 +8,16 @@
 #include "AITypes.h"
 #include "Abilities/Tasks/AbilityTask.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "PlayerMoveToDriver.h"
 #include "GameplayPlayerAITask_MoveTo.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGameplayPlayerMoveTaskCompletedSignature, TEnumAsByte<EPathFollowingResult::Type>, Result, APlayerController*, PlayerController);
 
 /**
  * Same as AIMoveTo but works with PlayerController
- * When used in a GameplayAbility use UGameplayGameplayPlayerAITask_MoveTo instead
+ * Version of UPlayerAITask_MoveTo for use in a GameplayAbility, outside of abilities use UPlayerAITask_MoveTo instead
  * This one requires the use of APlayerAIMoveToController or a controller with equivalent implementations
+ * Move logic lives in FPlayerMoveToDriver, shared with UPlayerAITask_MoveTo
  */
 UCLASS()
 class PLAYERMOVETO_API UGameplayPlayerAITask_MoveTo : public UAbilityTask
@@ -26,70 +28,81 @@ public:
 	UGameplayPlayerAITask_MoveTo(const FObjectInitializer& ObjectInitializer);
 
 	/** tries to start move request and handles retry timer */
-	void ConditionalPerformMove();
+	void ConditionalPerformMove() { Driver.ConditionalPerformMove(); }
 
 	/** prepare move task for activation */
 	void SetUp(APlayerController* Controller, const FAIMoveRequest& InMoveRequest);
 
 	/** taken from UAIBlueprintHelperLibrary to produce a PathFollowingComponent */
-	static UPathFollowingComponent* InitNavigationControl(AController& Controller);
+	static UPathFollowingComponent* InitNavigationControl(AController& Controller) { return FPlayerMoveToDriver::InitNavigationControl(Controller); }
 
-	EPathFollowingResult::Type GetMoveResult() const { return MoveResult; }
-	bool WasMoveSuccessful() const { return MoveResult == EPathFollowingResult::Success; }
-	bool WasMovePartial() const { return Path.IsValid() && Path->IsPartial(); }
+	EPathFollowingResult::Type GetMoveResult() const { return Driver.GetMoveResult(); }
+	bool WasMoveSuccessful() const { return Driver.WasMoveSuccessful(); }
+	bool WasMovePartial() const { return Driver.WasMovePartial(); }
+	const FPlayerMoveTelemetry& GetTelemetry() const { return Driver.GetTelemetry(); }
 
 	/** Move to Location using PlayerController instead of AIController. */
-	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE", DisplayName = "Gameplay Player Move To Location or Actor"))
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass,bUseAsyncPathfinding,GoalObservation", AutoCreateRefTerm = "GoalObservation", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE", DisplayName = "Gameplay Player Move To Location or Actor"))
 	static UGameplayPlayerAITask_MoveTo* GameplayPlayerAIMoveTo(UGameplayAbility* OwningAbility, FName TaskInstanceName, APlayerController* Controller, FVector GoalLocation, AActor* GoalActor = nullptr,
 		float AcceptanceRadius = -1.f, EAIOptionFlag::Type StopOnOverlap = EAIOptionFlag::Default, EAIOptionFlag::Type AcceptPartialPath = EAIOptionFlag::Default,
-		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr,
+		bool bUseAsyncPathfinding = false, const FPlayerMoveGoalObservation& GoalObservation = FPlayerMoveGoalObservation());
 
 	void InitMoveTask(APlayerController& PlayerControllerOwner, IGameplayTaskOwnerInterface& TaskOwner, uint8 InPriority);
-	
-	/** Allows custom move request tweaking. Note that all MoveRequest need to 
+
+	/** Allows custom move request tweaking. Note that all MoveRequest need to
 	 *	be performed before PerformMove is called. */
-	FAIMoveRequest& GetMoveRequestRef() { return MoveRequest; }
+	FAIMoveRequest& GetMoveRequestRef() { return Driver.GetMoveRequestRef(); }
+
+	/** Switch task into continuous tracking mode: keep following goal actor, path is retargeted when it moves and kept while it is within reach. Only pathfinding failure or external cancel will be able to stop this task. */
+	void SetContinuousGoalTracking(bool bEnable) { Driver.SetContinuousGoalTracking(bEnable); }
+
+	/** Set how the task reacts to its goal actor moving */
+	void SetGoalObservation(const FPlayerMoveGoalObservation& InGoalObservation) { Driver.SetGoalObservation(InGoalObservation); }
+
+	/** Switch task into async pathfinding mode: path query is processed by navigation system's async queue and move starts when the result arrives. */
+	void SetAsyncPathfinding(bool bEnable) { Driver.SetAsyncPathfinding(bEnable); }
+
+	/** Switch task into hierarchical mode: long moves to a location follow a coarse route and only search the next leg of it as the pawn advances.
+	 *  @param Waypoints - coarse route to the goal, e.g. from a road graph. Straight line to the goal if empty */
+	void SetHierarchicalPathfinding(bool bEnable, const TArray<FVector>& Waypoints = TArray<FVector>()) { Driver.SetHierarchicalPathfinding(bEnable, Waypoints); }
+
+	/** Allow goal outside of loaded navigation (e.g. World Partition cells that aren't streamed in): task moves to the closest loaded navigation and continues as it streams in. */
+	void SetStreamingGoal(bool bEnable) { Driver.SetStreamingGoal(bEnable); }
+
+	/** Switch task into client predicted mode, run it on the owning client: path is followed right away and validated by the server instead of being searched there. */
+	void SetClientPrediction(bool bEnable) { Driver.SetClientPrediction(bEnable); }
+
+	/** Replicate path of the task running on the server to the owning client, e.g. to draw the route. */
+	void SetPathReplication(bool bEnable) { Driver.SetPathReplication(bEnable); }
 
-	/** Switch task into continuous tracking mode: keep restarting move toward goal actor. Only pathfinding failure or external cancel will be able to stop this task. */
-	void SetContinuousGoalTracking(bool bEnable);
+	/** true while waiting for result of async path query */
+	bool IsWaitingForPath() const { return Driver.IsWaitingForPath(); }
+
+	/** Change goal of the active move instead of starting a new task, e.g. on every click of click to move
+	 *  @param GoalActor - move to this actor instead of GoalLocation if set
+	 *  @param bReusePathPrefix - finish segment pawn is currently walking and search from its end
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "bReusePathPrefix"))
+	void Retarget(FVector GoalLocation, AActor* GoalActor = nullptr, bool bReusePathPrefix = false) { Driver.Retarget(GoalLocation, GoalActor, bReusePathPrefix); }
 
 protected:
 	UPROPERTY(BlueprintReadOnly, Category="AI|Tasks")
 	TObjectPtr<APlayerController> OwnerController;
-	
-	UPROPERTY()
-	TObjectPtr<UPathFollowingComponent> PathFollowingComp;
-	
+
 	UPROPERTY(BlueprintAssignable)
 	FGenericGameplayTaskDelegate OnRequestFailed;
 
 	UPROPERTY(BlueprintAssignable)
 	FGameplayPlayerMoveTaskCompletedSignature OnMoveFinished;
 
-	/** parameters of move request */
-	UPROPERTY()
-	FAIMoveRequest MoveRequest;
-
-	/** handle of path following's OnMoveFinished delegate */
-	FDelegateHandle PathFinishDelegateHandle;
-
-	/** handle of path's update event delegate */
-	FDelegateHandle PathUpdateDelegateHandle;
-
-	/** handle of active ConditionalPerformMove timer  */
-	FTimerHandle MoveRetryTimerHandle;
-
-	/** handle of active ConditionalUpdatePath timer */
-	FTimerHandle PathRetryTimerHandle;
-
-	/** request ID of path following's request */
-	FAIRequestID MoveRequestID;
-
-	/** currently followed path */
-	FNavPathSharedPtr Path;
+	/** executed after the move ended with what happened during it */
+	UPROPERTY(BlueprintAssignable)
+	FPlayerMoveTelemetrySignature OnMoveTelemetry;
 
-	TEnumAsByte<EPathFollowingResult::Type> MoveResult;
-	uint8 bUseContinuousTracking : 1;
+	/** move logic */
+	UPROPERTY()
+	FPlayerMoveToDriver Driver;
 
 	virtual void Activate() override;
 	virtual void OnDestroy(bool bOwnerFinished) override;
@@ -97,46 +110,9 @@ protected:
 	virtual void Pause() override;
 	virtual void Resume() override;
 
-	bool ResumeMove(FAIRequestID RequestToResume) const;
-
 	/** finish task */
-	void FinishMoveTask(EPathFollowingResult::Type InResult);
-
-	/** stores path and starts observing its events */
-	void SetObservedPath(const FNavPathSharedPtr& InPath);
-
-	/** remove all delegates */
-	virtual void ResetObservers();
-
-	/** remove all timers */
-	virtual void ResetTimers();
-
-	/** tries to update invalidated path and handles retry timer */
-	void ConditionalUpdatePath();
-
-	/** start move request */
-	virtual void PerformMove();
-
-	/** Makes AI go toward specified destination. Taken from AAIController
-	 *  @param MoveRequest - details about move
-	 *  @param OutPath - optional output param, filled in with assigned path
-	 *  @return struct holding MoveId and enum code
-	 */
-	virtual FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr);
-
-	/** Taken from AAIController */
-	bool BuildPathfindingQuery(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query) const;
-	
-	/** Finds path for given move request. Taken from AAIController
-	  *  @param MoveRequest - details about move
-	 *  @param Query - pathfinding query for navigation system
-	 *  @param OutPath - generated path
-	 */
-	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const;
-
-	/** event from followed path */
-	virtual void OnPathEvent(FNavigationPath* InPath, ENavPathEvent::Type Event);
+	void FinishMoveTask(EPathFollowingResult::Type InResult) { Driver.FinishMoveTask(InResult); }
 
-	/** event from path following */
-	virtual void OnRequestFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
+	/** driver finished moving, end task and broadcast result */
+	virtual void OnDriverMoveFinished(EPathFollowingResult::Type InResult);
 };
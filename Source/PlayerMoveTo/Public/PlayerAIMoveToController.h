@@ -4,21 +4,38 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTaskOwnerInterface.h"
+#include "PlayerMoveToPathFollowingProvider.h"
+#include "PlayerMoveToNetTypes.h"
 #include "GameFramework/PlayerController.h"
 #include "PlayerAIMoveToController.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FPlayerPredictedPathRejected, uint32 /* MoveId */);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPlayerFollowedPathReplicated, const TArray<FVector>&, PathPoints);
+
 /**
  * This PlayerController is required when using UPlayerAITask_MoveTo, but not UGameplayPlayerAITask_MoveTo
  * If you're using only with gameplay abilities, it is not needed
+ *
+ * Also carries client predicted moves: owning client follows its own path and reports it, server validates
+ * the path against its navigation instead of searching it, and rejects it if it doesn't hold
+ * Server driven moves can replicate their path to the owning client the other way around
  */
 UCLASS(config=Game, BlueprintType, Blueprintable)
-class PLAYERMOVETO_API APlayerAIMoveToController : public APlayerController, public IGameplayTaskOwnerInterface
+class PLAYERMOVETO_API APlayerAIMoveToController : public APlayerController, public IGameplayTaskOwnerInterface, public IPlayerMoveToPathFollowingProvider
 {
 	GENERATED_BODY()
 
 public:
 	UPROPERTY()
 	TObjectPtr<UGameplayTasksComponent> CachedGameplayTasksComponent;
+
+	/** created ahead of the first move, so it doesn't hitch */
+	UPROPERTY()
+	TObjectPtr<UPathFollowingComponent> CachedPathFollowingComponent;
+
+	/** class of path following component created for player moves, UPlayerPathFollowingComponent steers through movement input */
+	UPROPERTY(EditDefaultsOnly, Category = "PlayerMoveTo")
+	TSubclassOf<UPathFollowingComponent> PathFollowingComponentClass;
 	
 	//----------------------------------------------------------------------//
 	// IGameplayTaskOwnerInterface
@@ -30,7 +47,78 @@ public:
 
 	FORCEINLINE UGameplayTasksComponent* GetGameplayTasksComponent() const { return CachedGameplayTasksComponent; }
 
+	//----------------------------------------------------------------------//
+	// IPlayerMoveToPathFollowingProvider
+	//----------------------------------------------------------------------//
+	virtual UPathFollowingComponent* GetPlayerPathFollowingComponent() const override { return CachedPathFollowingComponent; }
+
+	//----------------------------------------------------------------------//
+	// Client predicted moves
+	//----------------------------------------------------------------------//
+
+	/** filters predicted paths may be validated with, paths of moves using any other filter are validated with navigation data's default one
+	 *  Client only names the filter its move used, server never validates with a filter it didn't allow */
+	UPROPERTY(EditDefaultsOnly, Category = "PlayerMoveTo")
+	TArray<TSubclassOf<UNavigationQueryFilter>> PredictionFilterClasses;
+
+	/** client reports path of its predicted move, replaces previous one. Rate limited by PlayerMoveTo.Prediction.ReportInterval */
+	UFUNCTION(Server, Reliable)
+	void ServerSetPredictedPath(const FPlayerMovePathDigest& Digest);
+
+	/** client's predicted move ended */
+	UFUNCTION(Server, Reliable)
+	void ServerClearPredictedPath(uint32 MoveId);
+
+	/** server didn't accept the path of predicted move */
+	UFUNCTION(Client, Reliable)
+	void ClientRejectPredictedPath(uint32 MoveId);
+
+	/** path of owning client's predicted move accepted by the server, only valid on server
+	 *  Kept for game code, e.g. to check where the pawn is heading. Nothing reconciles the pawn with it,
+	 *  pawn's position is corrected by regular character movement */
+	const FPlayerMovePathDigest& GetPredictedPath() const { return PredictedPath; }
+	bool HasPredictedPath() const { return PredictedPath.IsValid(); }
+
+	/** executed on owning client when server rejects a predicted path */
+	FPlayerPredictedPathRejected OnPredictedPathRejected;
+
+	//----------------------------------------------------------------------//
+	// Replicated paths of server driven moves
+	//----------------------------------------------------------------------//
+
+	/** server sends path of its move, or the part of it that changed */
+	UFUNCTION(Client, Reliable)
+	void ClientSetFollowedPath(const FPlayerMoveNetPath& NetPath);
+
+	/** server's move ended */
+	UFUNCTION(Client, Reliable)
+	void ClientClearFollowedPath(uint32 MoveId);
+
+	/** @return path server is moving the pawn along from the segment pawn is on, long paths only up to PlayerMoveTo.NetPath.MaxPoints points. Empty if there is none, only valid on owning client */
+	UFUNCTION(BlueprintPure, Category = "PlayerMoveTo")
+	const TArray<FVector>& GetReplicatedPathPoints() const { return ReplicatedPathPoints; }
+
+	/** executed on owning client when replicated path changes, empty once the move ended */
+	UPROPERTY(BlueprintAssignable)
+	FPlayerFollowedPathReplicated OnFollowedPathReplicated;
+
+protected:
+	FPlayerMovePathDigest PredictedPath;
+
+	TArray<FVector> ReplicatedPathPoints;
+
+	/** server's move ReplicatedPathPoints belong to */
+	uint32 ReplicatedPathMoveId = 0;
+
+	/** index of server path's point ReplicatedPathPoints start at */
+	int32 ReplicatedPathStartIndex = 0;
+
+	/** @return true if pawn can follow Digest on server's navigation */
+	virtual bool ValidatePredictedPath(const FPlayerMovePathDigest& Digest) const;
+
 public:
 	void CacheGameplayTasksComponent(APawn* InPawn);
+	void CachePathFollowingComponent();
+	virtual void BeginPlay() override;
 	virtual void OnPossess(APawn* InPawn) override;
 };
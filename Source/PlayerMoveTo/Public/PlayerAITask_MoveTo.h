@@ -8,14 +8,18 @@
 #include "AITypes.h"
 #include "GameplayTask.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "PlayerMoveToDriver.h"
 #include "PlayerAITask_MoveTo.generated.h"
 
+class UPlayerMoveToTaskPoolSubsystem;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPlayerMoveTaskCompletedSignature, TEnumAsByte<EPathFollowingResult::Type>, Result, APlayerController*, PlayerController);
 
 /**
  * Same as AIMoveTo but works with PlayerController
  * When used in a GameplayAbility use UGameplayPlayerAITask_MoveTo instead
  * This one requires the use of APlayerAIMoveToController or a controller with equivalent implementations
+ * Move logic lives in FPlayerMoveToDriver, shared with UGameplayPlayerAITask_MoveTo
  */
 UCLASS()
 class PLAYERMOVETO_API UPlayerAITask_MoveTo : public UGameplayTask
@@ -26,117 +30,146 @@ public:
 	UPlayerAITask_MoveTo(const FObjectInitializer& ObjectInitializer);
 
 	/** tries to start move request and handles retry timer */
-	void ConditionalPerformMove();
+	void ConditionalPerformMove() { Driver.ConditionalPerformMove(); }
 
 	/** prepare move task for activation */
 	void SetUp(APlayerController* Controller, const FAIMoveRequest& InMoveRequest);
 
 	/** taken from UAIBlueprintHelperLibrary to produce a PathFollowingComponent */
-	static UPathFollowingComponent* InitNavigationControl(AController& Controller);
+	static UPathFollowingComponent* InitNavigationControl(AController& Controller) { return FPlayerMoveToDriver::InitNavigationControl(Controller); }
+
+	EPathFollowingResult::Type GetMoveResult() const { return Driver.GetMoveResult(); }
+	bool WasMoveSuccessful() const { return Driver.WasMoveSuccessful(); }
+	bool WasMovePartial() const { return Driver.WasMovePartial(); }
+	const FPlayerMoveTelemetry& GetTelemetry() const { return Driver.GetTelemetry(); }
+	const FNavPathSharedPtr& GetPath() const { return Driver.GetPath(); }
 
-	EPathFollowingResult::Type GetMoveResult() const { return MoveResult; }
-	bool WasMoveSuccessful() const { return MoveResult == EPathFollowingResult::Success; }
-	bool WasMovePartial() const { return Path.IsValid() && Path->IsPartial(); }
+	/** @return heap memory owned by the move besides the task object and its path */
+	SIZE_T GetAllocatedSize() const { return Driver.GetAllocatedSize(); }
 
 	/** Move to Location using PlayerController instead of AIController. Use "Gameplay Player Move To Location or Actor" instead for gameplay abilities */
-	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass", DefaultToSelf = "Controller", BlueprintInternalUseOnly = "TRUE", DisplayName = "Player Move To Location or Actor"))
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass,bUseAsyncPathfinding,GoalObservation", AutoCreateRefTerm = "GoalObservation", DefaultToSelf = "Controller", BlueprintInternalUseOnly = "TRUE", DisplayName = "Player Move To Location or Actor"))
 	static UPlayerAITask_MoveTo* PlayerAIMoveTo(APlayerController* Controller, FVector GoalLocation, AActor* GoalActor = nullptr,
 		float AcceptanceRadius = -1.f, EAIOptionFlag::Type StopOnOverlap = EAIOptionFlag::Default, EAIOptionFlag::Type AcceptPartialPath = EAIOptionFlag::Default,
-		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr,
+		bool bUseAsyncPathfinding = false, const FPlayerMoveGoalObservation& GoalObservation = FPlayerMoveGoalObservation());
+
+	/**
+	 * Move several players in one go, e.g. when gathering everyone at an objective
+	 * Goals are projected together and paths are searched in parallel, tasks are returned before activation
+	 * so results can be bound first, start them with ActivateBatch
+	 * @param GoalLocations - one goal per controller, or a single goal shared by all of them
+	 * @return tasks waiting for activation, failed requests broadcast OnRequestFailed on activation same as a single move
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass,GoalObservation", AutoCreateRefTerm = "GoalObservation", DisplayName = "Player Move To Location or Actor (Batch)"))
+	static TArray<UPlayerAITask_MoveTo*> PlayerAIMoveToBatch(const TArray<APlayerController*>& Controllers, const TArray<FVector>& GoalLocations, AActor* GoalActor = nullptr,
+		float AcceptanceRadius = -1.f, EAIOptionFlag::Type StopOnOverlap = EAIOptionFlag::Default, EAIOptionFlag::Type AcceptPartialPath = EAIOptionFlag::Default,
+		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr,
+		const FPlayerMoveGoalObservation& GoalObservation = FPlayerMoveGoalObservation());
+
+	/** Start tasks returned by PlayerAIMoveToBatch, bind to their results before calling this */
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (DisplayName = "Activate Player Move To Batch"))
+	static void ActivateBatch(const TArray<UPlayerAITask_MoveTo*>& Tasks);
+
+	/**
+	 * Move to whichever of several goals has the cheapest path, e.g. nearest car door or free seat
+	 * Goals are projected together and searched from the closest one with cost limited to the best path so far,
+	 * so usually a single search decides instead of one per goal. Selected goal is available from GetSelectedGoalIndex
+	 * @param GoalLocations - candidate locations
+	 * @param GoalActors - candidate actors, indexed after GoalLocations
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "AcceptanceRadius,StopOnOverlap,AcceptPartialPath,bUsePathfinding,bUseContinuousGoalTracking,ProjectGoalOnNavigation,FilterClass,GoalObservation", AutoCreateRefTerm = "GoalLocations,GoalActors,GoalObservation", DefaultToSelf = "Controller", BlueprintInternalUseOnly = "TRUE", DisplayName = "Player Move To Nearest Location or Actor"))
+	static UPlayerAITask_MoveTo* PlayerAIMoveToNearest(APlayerController* Controller, const TArray<FVector>& GoalLocations, const TArray<AActor*>& GoalActors,
+		float AcceptanceRadius = -1.f, EAIOptionFlag::Type StopOnOverlap = EAIOptionFlag::Default, EAIOptionFlag::Type AcceptPartialPath = EAIOptionFlag::Default,
+		bool bUsePathfinding = true, bool bUseContinuousGoalTracking = false, EAIOptionFlag::Type ProjectGoalOnNavigation = EAIOptionFlag::Default, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr,
+		const FPlayerMoveGoalObservation& GoalObservation = FPlayerMoveGoalObservation());
+
+	/** @return index of goal picked by PlayerAIMoveToNearest in its GoalLocations followed by GoalActors, INDEX_NONE for other moves */
+	UFUNCTION(BlueprintPure, Category = "AI|Tasks")
+	int32 GetSelectedGoalIndex() const { return SelectedGoalIndex; }
 
 	void InitMoveTask(APlayerController& PlayerControllerOwner, IGameplayTaskOwnerInterface& TaskOwner, uint8 InPriority);
-	
-	/** Allows custom move request tweaking. Note that all MoveRequest need to 
+
+	/** Allows custom move request tweaking. Note that all MoveRequest need to
 	 *	be performed before PerformMove is called. */
-	FAIMoveRequest& GetMoveRequestRef() { return MoveRequest; }
+	FAIMoveRequest& GetMoveRequestRef() { return Driver.GetMoveRequestRef(); }
 
-	/** Switch task into continuous tracking mode: keep restarting move toward goal actor. Only pathfinding failure or external cancel will be able to stop this task. */
-	void SetContinuousGoalTracking(bool bEnable);
+	/** Switch task into continuous tracking mode: keep following goal actor, path is retargeted when it moves and kept while it is within reach. Only pathfinding failure or external cancel will be able to stop this task. */
+	void SetContinuousGoalTracking(bool bEnable) { Driver.SetContinuousGoalTracking(bEnable); }
 
-protected:
-	UPROPERTY(BlueprintReadOnly, Category="AI|Tasks")
-	TObjectPtr<APlayerController> OwnerController;
-	
-	UPROPERTY()
-	TObjectPtr<UPathFollowingComponent> PathFollowingComp;
-	
-	UPROPERTY(BlueprintAssignable)
-	FGenericGameplayTaskDelegate OnRequestFailed;
+	/** Set how the task reacts to its goal actor moving */
+	void SetGoalObservation(const FPlayerMoveGoalObservation& InGoalObservation) { Driver.SetGoalObservation(InGoalObservation); }
 
-	UPROPERTY(BlueprintAssignable)
-	FPlayerMoveTaskCompletedSignature OnMoveFinished;
+	/** Switch task into async pathfinding mode: path query is processed by navigation system's async queue and move starts when the result arrives. */
+	void SetAsyncPathfinding(bool bEnable) { Driver.SetAsyncPathfinding(bEnable); }
 
-	/** parameters of move request */
-	UPROPERTY()
-	FAIMoveRequest MoveRequest;
+	/** Switch task into hierarchical mode: long moves to a location follow a coarse route and only search the next leg of it as the pawn advances.
+	 *  @param Waypoints - coarse route to the goal, e.g. from a road graph. Straight line to the goal if empty */
+	void SetHierarchicalPathfinding(bool bEnable, const TArray<FVector>& Waypoints = TArray<FVector>()) { Driver.SetHierarchicalPathfinding(bEnable, Waypoints); }
 
-	/** handle of path following's OnMoveFinished delegate */
-	FDelegateHandle PathFinishDelegateHandle;
+	/** Allow goal outside of loaded navigation (e.g. World Partition cells that aren't streamed in): task moves to the closest loaded navigation and continues as it streams in. */
+	void SetStreamingGoal(bool bEnable) { Driver.SetStreamingGoal(bEnable); }
 
-	/** handle of path's update event delegate */
-	FDelegateHandle PathUpdateDelegateHandle;
+	/** Switch task into client predicted mode, run it on the owning client: path is followed right away and validated by the server instead of being searched there. */
+	void SetClientPrediction(bool bEnable) { Driver.SetClientPrediction(bEnable); }
 
-	/** handle of active ConditionalPerformMove timer  */
-	FTimerHandle MoveRetryTimerHandle;
+	/** Replicate path of the task running on the server to the owning client, e.g. to draw the route. */
+	void SetPathReplication(bool bEnable) { Driver.SetPathReplication(bEnable); }
 
-	/** handle of active ConditionalUpdatePath timer */
-	FTimerHandle PathRetryTimerHandle;
+	/** true while waiting for result of async path query */
+	bool IsWaitingForPath() const { return Driver.IsWaitingForPath(); }
 
-	/** request ID of path following's request */
-	FAIRequestID MoveRequestID;
+	/** Change goal of the active move instead of starting a new task, e.g. on every click of click to move
+	 *  @param GoalActor - move to this actor instead of GoalLocation if set
+	 *  @param bReusePathPrefix - finish segment pawn is currently walking and search from its end
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Tasks", meta = (AdvancedDisplay = "bReusePathPrefix"))
+	void Retarget(FVector GoalLocation, AActor* GoalActor = nullptr, bool bReusePathPrefix = false) { Driver.Retarget(GoalLocation, GoalActor, bReusePathPrefix); }
 
-	/** currently followed path */
-	FNavPathSharedPtr Path;
+	/** set by UPlayerMoveToTaskPoolSubsystem, task returns to it once it ended instead of becoming garbage */
+	void SetPool(UPlayerMoveToTaskPoolSubsystem* InPool) { Pool = InPool; }
 
-	TEnumAsByte<EPathFollowingResult::Type> MoveResult;
-	uint8 bUseContinuousTracking : 1;
+	/** public so tasks of PlayerAIMoveToBatch can be bound to before ActivateBatch */
+	UPROPERTY(BlueprintAssignable)
+	FGenericGameplayTaskDelegate OnRequestFailed;
 
-	virtual void Activate() override;
-	virtual void OnDestroy(bool bOwnerFinished) override;
+	UPROPERTY(BlueprintAssignable)
+	FPlayerMoveTaskCompletedSignature OnMoveFinished;
 
-	virtual void Pause() override;
-	virtual void Resume() override;
+	/** executed after the move ended with what happened during it */
+	UPROPERTY(BlueprintAssignable)
+	FPlayerMoveTelemetrySignature OnMoveTelemetry;
 
-	bool ResumeMove(FAIRequestID RequestToResume) const;
+protected:
+	UPROPERTY(BlueprintReadOnly, Category="AI|Tasks")
+	TObjectPtr<APlayerController> OwnerController;
 
-	/** finish task */
-	void FinishMoveTask(EPathFollowingResult::Type InResult);
+	/** move logic */
+	UPROPERTY()
+	FPlayerMoveToDriver Driver;
 
-	/** stores path and starts observing its events */
-	void SetObservedPath(const FNavPathSharedPtr& InPath);
+	/** pool this task returns to once it ended */
+	TWeakObjectPtr<UPlayerMoveToTaskPoolSubsystem> Pool;
 
-	/** remove all delegates */
-	virtual void ResetObservers();
+	/** goal picked by PlayerAIMoveToNearest */
+	int32 SelectedGoalIndex;
 
-	/** remove all timers */
-	virtual void ResetTimers();
+	/** result delegates are being broadcast, returning to pool has to wait for them */
+	bool bBroadcastingResult;
+	bool bReturnAfterBroadcast;
 
-	/** tries to update invalidated path and handles retry timer */
-	void ConditionalUpdatePath();
+	virtual void Activate() override;
+	virtual void OnDestroy(bool bOwnerFinished) override;
 
-	/** start move request */
-	virtual void PerformMove();
+	virtual void Pause() override;
+	virtual void Resume() override;
 
-	/** Makes AI go toward specified destination. Taken from AAIController
-	 *  @param MoveRequest - details about move
-	 *  @param OutPath - optional output param, filled in with assigned path
-	 *  @return struct holding MoveId and enum code
-	 */
-	virtual FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr);
-
-	/** Taken from AAIController */
-	bool BuildPathfindingQuery(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query) const;
-	
-	/** Finds path for given move request. Taken from AAIController
-	  *  @param MoveRequest - details about move
-	 *  @param Query - pathfinding query for navigation system
-	 *  @param OutPath - generated path
-	 */
-	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const;
+	/** finish task */
+	void FinishMoveTask(EPathFollowingResult::Type InResult) { Driver.FinishMoveTask(InResult); }
 
-	/** event from followed path */
-	virtual void OnPathEvent(FNavigationPath* InPath, ENavPathEvent::Type Event);
+	/** driver finished moving, end task and broadcast result */
+	virtual void OnDriverMoveFinished(EPathFollowingResult::Type InResult);
 
-	/** event from path following */
-	virtual void OnRequestFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
+	/** reset task and hand it back to Pool */
+	void ReturnToPool();
 };
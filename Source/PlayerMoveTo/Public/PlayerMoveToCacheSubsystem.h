@@ -0,0 +1,123 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "PlayerMoveToCacheSubsystem.generated.h"
+
+class ANavigationData;
+class UNavigationQueryFilter;
+
+/**
+ * Identifies path requests that can share a path
+ * Start and goal are quantized so that requests from roughly the same spot towards the same goal map to the same entry
+ */
+struct PLAYERMOVETO_API FPlayerMovePathCacheKey
+{
+	FPlayerMovePathCacheKey() = default;
+	FPlayerMovePathCacheKey(const FPathFindingQuery& Query, const FNavAgentProperties& AgentProps, TSubclassOf<UNavigationQueryFilter> FilterClass);
+
+	bool IsValid() const { return NavData != nullptr; }
+
+	bool operator==(const FPlayerMovePathCacheKey& Other) const
+	{
+		return Start == Other.Start && Goal == Other.Goal && NavData == Other.NavData && AgentHash == Other.AgentHash && FilterClass == Other.FilterClass;
+	}
+
+	friend uint32 GetTypeHash(const FPlayerMovePathCacheKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Start), GetTypeHash(Key.Goal));
+		Hash = HashCombine(Hash, GetTypeHash(Key.NavData));
+		Hash = HashCombine(Hash, Key.AgentHash);
+		return HashCombine(Hash, GetTypeHash(Key.FilterClass));
+	}
+
+	FIntVector Start = FIntVector::ZeroValue;
+	FIntVector Goal = FIntVector::ZeroValue;
+	const ANavigationData* NavData = nullptr;
+	uint32 AgentHash = 0;
+	const UClass* FilterClass = nullptr;
+};
+
+/**
+ * Caches path corridors of completed player move requests, so repeated moves (same door, same lever, same vendor)
+ * cost a hash lookup and a string pull instead of a full path search
+ *
+ * Entries aren't registered with the navigation data, so navmesh rebuilds don't have to walk them; an entry is
+ * dropped on lookup when any poly of its corridor was rebuilt. Only the copy handed to a move is registered
+ *
+ * Goal projections of the most recent goals are kept as well, they expire after a short time instead
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @return cache for World or nullptr if path caching is disabled */
+	static UPlayerMoveToCacheSubsystem* Get(const UWorld* World);
+
+	/** @return new path built from cached corridor for Query, or nullptr on cache miss */
+	FNavPathSharedPtr FindPath(const FPlayerMovePathCacheKey& Key, const FPathFindingQuery& Query);
+
+	/** store corridor of a successful path search */
+	void AddPath(const FPlayerMovePathCacheKey& Key, const FNavPathSharedPtr& InPath);
+
+	/** drop all cached paths */
+	void FlushPaths();
+
+	int32 GetNumCachedPaths() const { return PathCache.Num(); }
+	uint32 GetNumHits() const { return NumHits; }
+	uint32 GetNumMisses() const { return NumMisses; }
+
+	/** @return true if projection of Goal onto NavData was found in cache */
+	bool FindProjection(const ANavigationData* NavData, const FVector& Goal, FNavLocation& OutLocation);
+
+	/** store result of a successful goal projection */
+	void AddProjection(const ANavigationData* NavData, const FVector& Goal, const FNavLocation& Location);
+
+	int32 GetNumCachedProjections() const { return ProjectionCache.Num(); }
+	uint32 GetNumProjectionHits() const { return NumProjectionHits; }
+	uint32 GetNumProjectionMisses() const { return NumProjectionMisses; }
+
+protected:
+	struct FCachedPath
+	{
+		/** copy of the path, not registered with the navigation data */
+		FNavPathSharedPtr Path;
+		double LastUsedTime = 0.0;
+	};
+
+	TMap<FPlayerMovePathCacheKey, FCachedPath> PathCache;
+
+	uint32 NumHits = 0;
+	uint32 NumMisses = 0;
+
+	struct FProjectionKey
+	{
+		const ANavigationData* NavData = nullptr;
+		FIntVector Goal = FIntVector::ZeroValue;
+
+		bool operator==(const FProjectionKey& Other) const { return NavData == Other.NavData && Goal == Other.Goal; }
+		friend uint32 GetTypeHash(const FProjectionKey& Key) { return HashCombine(GetTypeHash(Key.NavData), GetTypeHash(Key.Goal)); }
+	};
+
+	struct FCachedProjection
+	{
+		FNavLocation Location;
+		double AddedTime = 0.0;
+	};
+
+	TMap<FProjectionKey, FCachedProjection> ProjectionCache;
+
+	uint32 NumProjectionHits = 0;
+	uint32 NumProjectionMisses = 0;
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** remove least recently used entries until there is room for a new one */
+	void TrimPathCache(int32 MaxEntries);
+};
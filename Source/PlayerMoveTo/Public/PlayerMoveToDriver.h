@@ -0,0 +1,550 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "AITypes.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "PlayerMoveToCacheSubsystem.h"
+#include "PlayerMoveToTelemetrySubsystem.h"
+#include "PlayerMoveToDriver.generated.h"
+
+class APlayerController;
+class UGameplayTask;
+class UGameplayTasksComponent;
+struct FNavigationProjectionWork;
+
+DECLARE_DELEGATE_OneParam(FPlayerMoveToDriverFinished, EPathFollowingResult::Type /* Result */);
+
+/**
+ * How a move reacts to its goal actor moving
+ * Path is updated once goal actor gets further than the tolerance from where it was when the path was found, tolerance scales
+ * with distance to the goal so far away goals are observed coarsely and the end of the move is precise
+ */
+USTRUCT(BlueprintType)
+struct PLAYERMOVETO_API FPlayerMoveGoalObservation
+{
+	GENERATED_BODY()
+
+	FPlayerMoveGoalObservation()
+		: MinTolerance(100.f)
+		, MaxTolerance(500.f)
+		, DistanceScale(0.1f)
+		, MaxRepathRate(2.f)
+	{}
+
+	/** tolerance close to the goal */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0", ForceUnits = "cm"))
+	float MinTolerance;
+
+	/** tolerance far away from the goal */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0", ForceUnits = "cm"))
+	float MaxTolerance;
+
+	/** tolerance is distance to the goal multiplied by this, clamped between MinTolerance and MaxTolerance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0"))
+	float DistanceScale;
+
+	/** maximum path updates per second caused by goal actor moving, 0 is unlimited */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0"))
+	float MaxRepathRate;
+};
+
+/**
+ * Move logic shared by UPlayerAITask_MoveTo and UGameplayPlayerAITask_MoveTo
+ * The owning task forwards Activate, Pause, Resume and OnDestroy, and ends itself from OnMoveFinished
+ * Delegates and timers are bound to the owning task, so they can't outlive it
+ */
+USTRUCT()
+struct PLAYERMOVETO_API FPlayerMoveToDriver
+{
+	GENERATED_BODY()
+
+	FPlayerMoveToDriver();
+
+	/** bind to the task that owns this driver, called from the owning task's constructor */
+	void Initialize(UGameplayTask& InOwnerTask);
+
+	/** prepare move for activation */
+	void SetUp(APlayerController* Controller, const FAIMoveRequest& InMoveRequest);
+
+	/** set controller that will be moved */
+	void SetController(APlayerController* Controller) { OwnerController = Controller; }
+
+	/** taken from UAIBlueprintHelperLibrary to produce a PathFollowingComponent */
+	static UPathFollowingComponent* InitNavigationControl(AController& Controller);
+
+	/** Switch into continuous tracking mode: keep following goal actor, path is retargeted when it moves and kept while it is within reach. Only pathfinding failure or external cancel will be able to stop this task. */
+	void SetContinuousGoalTracking(bool bEnable) { bUseContinuousTracking = bEnable; }
+
+	/** Set how the move reacts to its goal actor moving */
+	void SetGoalObservation(const FPlayerMoveGoalObservation& InGoalObservation) { GoalObservation = InGoalObservation; }
+	const FPlayerMoveGoalObservation& GetGoalObservation() const { return GoalObservation; }
+
+	/** Switch into async pathfinding mode: path query is processed by navigation system's async queue and move starts when the result arrives.
+	 *  Overridden by PlayerMoveTo.PathfindingMode cvar */
+	void SetAsyncPathfinding(bool bEnable) { bUseAsyncPathfinding = bEnable; }
+
+	/** Switch into hierarchical mode for long moves to a location: move follows a coarse route and only searches paths for
+	 *  the next leg of it, next leg is searched and appended ahead of the pawn as it advances (PlayerMoveTo.Hierarchical cvars)
+	 *  @param Waypoints - coarse route to the goal, e.g. from a road graph. Straight line to the goal if empty
+	 */
+	void SetHierarchicalPathfinding(bool bEnable, const TArray<FVector>& Waypoints = TArray<FVector>())
+	{
+		bUseHierarchicalPathfinding = bEnable;
+		RouteWaypoints = Waypoints;
+	}
+
+	/** Allow goal location outside of loaded navigation, e.g. in World Partition cells that aren't streamed in yet:
+	 *  move heads to the closest loaded navigation towards the goal and continues as more of it streams in (PlayerMoveTo.Streaming cvars)
+	 */
+	void SetStreamingGoal(bool bEnable) { bUseStreamingGoal = bEnable; }
+
+	/** Switch into client predicted mode for moves run on the owning client of APlayerAIMoveToController:
+	 *  client follows its own path right away and reports it to the server, which validates it instead of searching it.
+	 *  Move is aborted if the server rejects the path
+	 */
+	void SetClientPrediction(bool bEnable) { bUseClientPrediction = bEnable; }
+
+	/** Replicate followed path to the owning client of APlayerAIMoveToController when the move runs on the server,
+	 *  so it can draw the route. Only points that changed are sent on path updates (PlayerMoveTo.NetPath cvars)
+	 */
+	void SetPathReplication(bool bEnable) { bReplicatePath = bEnable; }
+
+	APlayerController* GetController() const { return OwnerController; }
+	UPathFollowingComponent* GetPathFollowingComponent() const { return PathFollowingComp; }
+	const FNavPathSharedPtr& GetPath() const { return Path; }
+
+	/** @return heap memory owned by the driver, followed path is not included */
+	SIZE_T GetAllocatedSize() const;
+
+	/** @return memory of InPath's points and, for navmesh paths, its corridor */
+	static SIZE_T GetPathAllocatedSize(const FNavigationPath& InPath);
+
+	/** Allows custom move request tweaking. Note that all MoveRequest need to
+	 *	be performed before PerformMove is called. */
+	FAIMoveRequest& GetMoveRequestRef() { return MoveRequest; }
+	const FAIMoveRequest& GetMoveRequest() const { return MoveRequest; }
+
+	EPathFollowingResult::Type GetMoveResult() const { return MoveResult; }
+	bool WasMoveSuccessful() const { return MoveResult == EPathFollowingResult::Success; }
+	bool WasMovePartial() const { return Path.IsValid() && Path->IsPartial(); }
+
+	/** telemetry of current move, complete once it finished */
+	const FPlayerMoveTelemetry& GetTelemetry() const { return Telemetry; }
+
+	/** true while waiting for result of async path query */
+	bool IsWaitingForPath() const { return AsyncPathQueryID != INVALID_NAVQUERYID; }
+
+	/** Projects goals and finds paths for all drivers at once, ahead of their activation
+	 *  Goals are projected in one batch per navigation data and path searches run in parallel on worker threads,
+	 *  found paths are used by the next PerformMove instead of searching again
+	 */
+	static void FindPathsBatch(TArrayView<FPlayerMoveToDriver* const> Drivers);
+
+	/** Pick the goal with the cheapest path out of several candidates and make it the goal of this move, ahead of activation
+	 *  Candidates are searched from the closest one with cost limited to the cheapest path found so far, so a single
+	 *  search usually decides. Found path is used by the next PerformMove
+	 *  @return index of selected goal in GoalLocations followed by GoalActors, INDEX_NONE if there are no valid candidates
+	 */
+	int32 SelectNearestGoal(const TArray<FVector>& GoalLocations, const TArray<AActor*>& GoalActors);
+
+	/** Project goal onto navigation with PlayerMoveTo.GoalProjection extent, reusing recent projections of the same goal */
+	static bool ProjectGoal(const ANavigationData& NavData, const FVector& Goal, FNavLocation& OutLocation);
+
+	/** Project several candidate goals onto navigation at once, goals that aren't cached are projected in one batch */
+	static void ProjectGoals(const ANavigationData& NavData, TArray<FNavigationProjectionWork>& Workload);
+
+	static FVector GetGoalProjectionExtent(const ANavigationData& NavData);
+
+	/** Build pathfinding query of MoveRequest for Controller without a move, e.g. for reachability queries
+	 *  @param Querier - object navigation query filter is created for
+	 *  @return false if there is no navigation data for the request
+	 */
+	static bool BuildPathfindingQuery(const APlayerController& Controller, const FAIMoveRequest& MoveRequest, const UObject* Querier, FPathFindingQuery& Query);
+
+	/** @return location MoveRequest of Controller is heading to, taking goal actor's move goal offset into account */
+	static FVector GetMoveGoalLocation(const APlayerController& Controller, const FAIMoveRequest& MoveRequest);
+
+	/** called from owning task's Activate */
+	void Activate();
+
+	/** called from owning task's Pause */
+	void Pause();
+
+	/** called from owning task's Resume */
+	void Resume();
+
+	/** called from owning task's OnDestroy, stops everything that is still running */
+	void Cleanup();
+
+	/** cleanup and return to the state of a newly created driver, for reusing owning task */
+	void ResetForReuse();
+
+	/** tries to start move request and handles retry timer */
+	void ConditionalPerformMove();
+
+	/** Change goal of the move without restarting it, e.g. for click to move
+	 *  Path following request and observers are kept and the followed path is replaced in place when moving between locations,
+	 *  other moves are requested again by the same task. Paused moves pick the new goal up when resumed
+	 *  @param GoalActor - move to this actor instead of GoalLocation if set
+	 *  @param bReusePathPrefix - finish segment pawn is currently walking and search from its end
+	 */
+	void Retarget(const FVector& GoalLocation, AActor* GoalActor = nullptr, bool bReusePathPrefix = false);
+
+	/** stop moving and notify owning task through OnMoveFinished */
+	void FinishMoveTask(EPathFollowingResult::Type InResult);
+
+	/** executed when move is finished, owning task is expected to end itself */
+	FPlayerMoveToDriverFinished OnMoveFinished;
+
+protected:
+	/** task that owns this driver, not a UPROPERTY as the driver is always a member of it */
+	UGameplayTask* OwnerTask;
+
+	UPROPERTY()
+	TObjectPtr<APlayerController> OwnerController;
+
+	UPROPERTY()
+	TObjectPtr<UPathFollowingComponent> PathFollowingComp;
+
+	/** parameters of move request */
+	UPROPERTY()
+	FAIMoveRequest MoveRequest;
+
+	/** how the move reacts to its goal actor moving */
+	UPROPERTY()
+	FPlayerMoveGoalObservation GoalObservation;
+
+	/** handle of path following's OnMoveFinished delegate */
+	FDelegateHandle PathFinishDelegateHandle;
+
+	/** handle of path's update event delegate */
+	FDelegateHandle PathUpdateDelegateHandle;
+
+	/** handle of controller's OnPredictedPathRejected delegate */
+	FDelegateHandle PredictionRejectedHandle;
+
+	/** handle of ConditionalPerformMove waiting for navigation */
+	FDelegateHandle MoveRetryHandle;
+
+	/** handle of ConditionalUpdatePath waiting for navigation */
+	FDelegateHandle PathRetryHandle;
+
+	/** handle of active UpdateGoalTracking timer, used by all moves to a goal actor */
+	FTimerHandle GoalTrackingTimerHandle;
+
+	/** handle of active UpdateRoute timer */
+	FTimerHandle RouteTimerHandle;
+
+	/** handle of active UpdateNetPathWindow timer */
+	FTimerHandle NetPathTimerHandle;
+
+	/** handle of timer sending rate limited update of predicted path */
+	FTimerHandle PredictionReportTimerHandle;
+
+	/** request ID of path following's request */
+	FAIRequestID MoveRequestID;
+
+	/** currently followed path */
+	FNavPathSharedPtr Path;
+
+	/** move ID of the last path reported to the server, 0 if none */
+	uint32 PredictedMoveId;
+
+	/** quantized points of the path window last replicated to the owning client */
+	TArray<FVector> ReplicatedPathPoints;
+
+	/** index of followed path's point ReplicatedPathPoints start at */
+	int32 ReplicatedPathStartIndex;
+
+	/** move ID of ReplicatedPathPoints, 0 if none */
+	uint32 ReplicatedMoveId;
+
+	/** path found by FindPathsBatch, used by next MoveTo */
+	FNavPathSharedPtr PrecomputedPath;
+
+	/** ID of pending async path query */
+	uint32 AsyncPathQueryID;
+
+	/** path cache entry the pending async query result is stored in */
+	FPlayerMovePathCacheKey AsyncPathCacheKey;
+
+	/** what happened during this move so far */
+	UPROPERTY()
+	FPlayerMoveTelemetry Telemetry;
+
+	/** times followed path was retargeted without searching since last PerformMove */
+	int32 NumPathExtensions;
+
+	/** coarse route of hierarchical move, move goal is not included */
+	TArray<FVector> RouteWaypoints;
+
+	/** first waypoint of RouteWaypoints not covered by searched legs */
+	int32 RouteWaypointIndex;
+
+	/** game time of last path update caused by goal actor moving */
+	double LastGoalRepathTime;
+
+	/** game time predicted path was last sent to the server */
+	double LastPredictionReportTime;
+
+	/** location of goal actor when followed path was last set or updated */
+	FVector ObservedGoalLocation;
+
+	/** real and game time of activation, for telemetry */
+	double ActivationRealTime;
+	double ActivationGameTime;
+
+	TEnumAsByte<EPathFollowingResult::Type> MoveResult;
+	uint8 bUseContinuousTracking : 1;
+	uint8 bUseAsyncPathfinding : 1;
+
+	/** pending async path query runs on UPlayerMoveToQuerySubsystem instead of navigation system's async queue */
+	uint8 bAsyncPathQueryOnWorker : 1;
+
+	/** included in active task stats, between Activate and Cleanup */
+	uint8 bCountedAsActive : 1;
+
+	/** telemetry of this move was already recorded */
+	uint8 bTelemetryRecorded : 1;
+
+	/** goal tracking reached its goal and waits for it to move away */
+	uint8 bHoldingAtGoal : 1;
+
+	uint8 bUseHierarchicalPathfinding : 1;
+	uint8 bUseStreamingGoal : 1;
+
+	/** followed path leads to move goal, no more route legs to search */
+	uint8 bOnFinalLeg : 1;
+
+	/** reached end of loaded navigation and waits for more of it to stream in */
+	uint8 bHoldingAtRouteEnd : 1;
+
+	uint8 bUseClientPrediction : 1;
+	uint8 bReplicatePath : 1;
+
+	/** goal changed while owning task was paused, applied on resume */
+	uint8 bPendingRetarget : 1;
+
+	/** pending retarget only changed location goals, followed path can be retargeted in place */
+	uint8 bPendingRetargetKeepsRequest : 1;
+	uint8 bPendingRetargetReusesPrefix : 1;
+
+	/** followed path changed since it was last reported to the server, sent once report interval passes */
+	uint8 bPredictionReportPending : 1;
+
+	UWorld* GetWorld() const;
+	UGameplayTasksComponent* GetGameplayTasksComponent() const;
+	FString GetName() const;
+
+	bool ResumeMove(FAIRequestID RequestToResume) const;
+
+	/** stores path and starts observing its events */
+	void SetObservedPath(const FNavPathSharedPtr& InPath);
+
+	/** update path stats of telemetry */
+	void RecordPathTelemetry(const FNavigationPath& InPath);
+
+	/** finalize telemetry and store it in UPlayerMoveToTelemetrySubsystem */
+	void RecordTelemetry(EPathFollowingResult::Type InResult);
+
+	/** followed path was set or changed, keeps telemetry and network up to date */
+	void OnFollowedPathUpdated(const FNavigationPath& InPath);
+
+	/** send points of followed path's window ahead of the pawn that changed since last update to the owning client */
+	void ReplicateFollowedPath(const FNavigationPath& InPath);
+
+	/** @return index of InPath's first replicated point, the segment pawn is on if InPath is followed */
+	int32 GetNetPathStartIndex(const FNavigationPath& InPath) const;
+
+	/** start moving replicated window forward while the client doesn't have the whole path */
+	void StartNetPathUpdates();
+
+	/** replicate the next window of the followed path once pawn gets close to the end of the replicated one */
+	void UpdateNetPathWindow();
+
+	/** tell the owning client replicated path ended */
+	void StopReplicatingPath();
+
+	/** true if followed paths are reported to the server */
+	bool IsPredictingClient() const;
+
+	/** send followed path to the server for validation, updates of the same move at most once per PlayerMoveTo.Prediction.ReportInterval */
+	void ReportPredictedPath(const FNavigationPath& InPath);
+
+	/** tell the server predicted move ended */
+	void StopPredictedPath();
+
+	/** remove all delegates */
+	void ResetObservers();
+
+	/** remove all timers and stop waiting for navigation */
+	void ResetTimers();
+
+	/** Retry is executed once navigation may be ready to path again
+	 *  @return handle that stays valid until Retry runs or StopWaitingForNavigation is called
+	 */
+	FDelegateHandle WaitForNavigation(TFunction<void()>&& Retry);
+
+	void StopWaitingForNavigation(FDelegateHandle& Handle);
+
+	/** tries to update invalidated path and handles retry timer */
+	void ConditionalUpdatePath();
+
+	/** Keeps the part of invalidated path that can still be walked and only searches from its end to the goal
+	 *  @return true if path was repaired, false if it needs a full repath
+	 */
+	bool RepairPath(ANavigationData& NavData);
+
+	/** @return new request to GoalActor or GoalLocation with all other settings copied from Settings */
+	static FAIMoveRequest MakeMoveRequest(const FAIMoveRequest& Settings, const FVector& GoalLocation, AActor* GoalActor = nullptr);
+
+	/** move to the goal of MoveRequest after it was changed by Retarget
+	 *  @param bKeepRequest - only location goals changed, try replacing followed path before requesting the move again
+	 */
+	void ApplyRetarget(bool bKeepRequest, bool bReusePathPrefix);
+
+	/** Replace followed path with a path to the new location goal, keeping path following request
+	 *  @return true if path was replaced, false if move needs to be requested again
+	 */
+	bool RetargetFollowedPath(bool bReusePathPrefix);
+
+	/** Replace points of followed path and notify path following
+	 *  @param SearchedPath - path the new points were searched with, its corridor follows the kept one
+	 *  @param KeptFirstIndex, KeptLastIndex - points of followed path kept at the start of NewPoints, their part of the corridor is kept
+	 */
+	void UpdatePathInPlace(TArray<FNavPathPoint>&& NewPoints, const FNavigationPath* SearchedPath, ENavPathUpdateType::Type UpdateType,
+		int32 KeptFirstIndex = INDEX_NONE, int32 KeptLastIndex = INDEX_NONE);
+
+	/** true if move is split into route legs */
+	bool IsFollowingRoute() const;
+
+	/** true if route legs are cut by distance, not only by loaded navigation */
+	bool UsesRouteLegs() const;
+
+	static FVector GetRouteProjectionExtent(const ANavigationData& NavData);
+
+	/** Find loaded navigation closest to Goal on the line from query's start
+	 *  @return false if there is none besides the start
+	 */
+	bool FindLoadedNavigationTowards(const FPathFindingQuery& Query, const FVector& Goal, FVector& OutLocation) const;
+
+	/** Find end of the next route leg for Query
+	 *  @return false if Query can head to the goal directly
+	 */
+	bool FindRouteLeg(const FPathFindingQuery& Query, int32& InOutWaypointIndex, FVector& OutLegGoal) const;
+
+	/** true if a new leg would get the pawn somewhere, false while it waits at the end of loaded navigation */
+	bool CanAdvanceRoute() const;
+
+	/** Find where route leg starting at From ends
+	 *  @return false if Goal is within reach of the leg
+	 */
+	bool GetRouteLegGoal(const FVector& From, const FVector& Goal, int32& InOutWaypointIndex, FVector& OutLegGoal) const;
+
+	/** shorten query to the next route leg if move follows a route */
+	void ApplyRouteLeg(FPathFindingQuery& Query);
+
+	void StartRouteUpdates();
+
+	/** search next route leg once pawn gets close to the end of the followed one */
+	void UpdateRoute();
+
+	/** start move request */
+	void PerformMove();
+
+	/** Makes AI go toward specified destination. Taken from AAIController
+	 *  @param MoveRequest - details about move
+	 *  @param OutPath - optional output param, filled in with assigned path
+	 *  @return struct holding MoveId and enum code
+	 */
+	FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr);
+
+	/** @return location move request is heading to, taking goal actor's move goal offset into account */
+	FVector GetMoveGoalLocation(const FAIMoveRequest& MoveRequest) const;
+
+	/** Taken from AAIController */
+	bool BuildPathfindingQuery(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query) const;
+
+	/** Finds path for given move request. Taken from AAIController
+	 *  @param MoveRequest - details about move
+	 *  @param Query - pathfinding query for navigation system
+	 *  @param OutPath - generated path
+	 */
+	void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const;
+
+	/** Looks up path for given move request in UPlayerMoveToCacheSubsystem
+	 *  @return true if OutPath was filled from cache
+	 */
+	bool FindCachedPath(const FAIMoveRequest& MoveRequest, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const;
+
+	/** post-process path that is about to be followed, if PlayerMoveTo.Smoothing is enabled */
+	void SmoothFoundPath(const FNavPathSharedPtr& InPath) const;
+
+	/** @return path found by FindPathsBatch if it is still valid and starts at the pawn, it is only used once */
+	FNavPathSharedPtr ConsumePrecomputedPath(const FAIMoveRequest& MoveRequest);
+
+	/** set up goal observation on freshly found path */
+	void PrepareFoundPath(const FAIMoveRequest& MoveRequest, const FNavPathSharedPtr& InPath) const;
+
+	/** Submits path query to navigation system's async queue, move is requested from OnAsyncPathFound
+	 *  @param bOnWorker - search on task graph workers through UPlayerMoveToQuerySubsystem instead
+	 *  @return true if query was submitted
+	 */
+	bool FindPathAsyncForMoveRequest(const FAIMoveRequest& MoveRequest, const FPathFindingQuery& Query, bool bOnWorker = false);
+
+	/** result of async path query */
+	void OnAsyncPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr InPath);
+
+	/** request path following along InPath and observe it
+	 *  @return true if path following accepted the request
+	 */
+	bool RequestMoveOnPath(const FNavPathSharedPtr& InPath);
+
+	/** cancel pending async path query */
+	void AbortAsyncPathRequest();
+
+	/** event from followed path */
+	void OnPathEvent(FNavigationPath* InPath, ENavPathEvent::Type Event);
+
+	/** event from path following */
+	void OnRequestFinished(FAIRequestID RequestID, const FPathFollowingResult& Result);
+
+	/** true if continuous tracking of a goal actor is active */
+	bool IsTrackingGoal() const { return bUseContinuousTracking && MoveRequest.IsMoveToActorRequest(); }
+
+	/** start polling goal actor location of moves to a goal actor */
+	void StartGoalTracking();
+
+	/** retarget path if goal actor moved too far from its end, UpdateGoalObservation if continuous tracking isn't used */
+	void UpdateGoalTracking();
+
+	/** repath if goal actor moved further than tolerance from where it was when the path was last updated */
+	void UpdateGoalObservation();
+
+	/** @return distance goal actor can move away from where it was when the path was found before the path is updated */
+	float GetGoalObservationTolerance(const FVector& GoalLocation) const;
+
+	/** @return true if goal observation's repath rate allows another path update */
+	bool CanRepathForGoal() const;
+
+	/** follow goal actor in straight line or by extending current path in place if possible, search new path otherwise */
+	void RetargetPath(const FVector& GoalLocation);
+
+	/** true while path following moves along Path for this driver's request */
+	bool IsFollowingObservedPath() const;
+
+	/** @return true if navigation raycast between Start and End isn't blocked */
+	bool HasNavigationLineOfSight(const ANavigationData& NavData, const FVector& Start, const FVector& End) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPlayerMoveToDriver> : public TStructOpsTypeTraitsBase2<FPlayerMoveToDriver>
+{
+	enum
+	{
+		WithCopy = false,
+	};
+};
@@ -0,0 +1,55 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "PlayerMoveToNavReadySubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Shared waiting list for player moves that can't path while navigation is being built
+ *
+ * All waiting moves are woken together when navigation generation finishes, instead of each one polling
+ * ShouldPostponePathUpdates on its own timer. A single fallback poll covers postpone reasons that don't
+ * come with a navigation event
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToNavReadySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPlayerMoveToNavReadySubsystem* Get(const UWorld* World);
+
+	/** Delegate is executed once on next wake up, it has to call this again if it still can't path
+	 *  @return handle for StopWaiting
+	 */
+	FDelegateHandle WaitForNavigation(const FSimpleDelegate& Delegate);
+
+	void StopWaiting(FDelegateHandle Handle);
+
+	/** wake all waiting moves */
+	void NotifyNavigationReady();
+
+	bool HasWaitingMoves() const { return OnNavigationReady.IsBound(); }
+
+protected:
+	FSimpleMulticastDelegate OnNavigationReady;
+
+	FTimerHandle PollTimerHandle;
+
+	/** navigation system we are listening to, it can be created after this subsystem */
+	TWeakObjectPtr<class UNavigationSystemV1> BoundNavSys;
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void BindToNavigationSystem();
+	void UpdatePollTimer();
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+};
@@ -0,0 +1,97 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "Templates/SubclassOf.h"
+#include "PlayerMoveToNetTypes.generated.h"
+
+class UNavigationQueryFilter;
+struct FNavigationPath;
+
+/**
+ * Path a client predicted move follows, sent to the server so it can validate the move instead of searching it again
+ * Long paths are cut to PlayerMoveTo.Prediction.MaxPathPoints, points past it aren't validated
+ */
+USTRUCT()
+struct PLAYERMOVETO_API FPlayerMovePathDigest
+{
+	GENERATED_BODY()
+
+	FPlayerMovePathDigest()
+		: MoveId(0)
+		, bPartial(false)
+	{}
+
+	FPlayerMovePathDigest(uint32 InMoveId, const FNavigationPath& Path, TSubclassOf<UNavigationQueryFilter> InFilterClass = nullptr);
+
+	bool IsValid() const { return MoveId != 0 && PathPoints.Num() > 0; }
+
+	/** @return number of points sent and validated */
+	static int32 GetMaxPathPoints();
+
+	/** client's path following request the path belongs to */
+	UPROPERTY()
+	uint32 MoveId;
+
+	UPROPERTY()
+	TArray<FVector_NetQuantize> PathPoints;
+
+	/** filter the path was searched with, server validates with it only if it is one of controller's PredictionFilterClasses */
+	UPROPERTY()
+	TSubclassOf<UNavigationQueryFilter> FilterClass;
+
+	UPROPERTY()
+	bool bPartial;
+};
+
+/**
+ * Path followed by a server driven move, replicated to the owning client so it can draw the route without searching it
+ * Long paths are sent in windows starting at the segment pawn is on, client drops points before StartIndex
+ * Points are sent in whole centimeters as deltas from the previous point, path updates only send the points that changed
+ */
+USTRUCT()
+struct PLAYERMOVETO_API FPlayerMoveNetPath
+{
+	GENERATED_BODY()
+
+	FPlayerMoveNetPath()
+		: MoveId(0)
+		, StartIndex(0)
+		, FirstPointIndex(0)
+		, bPartial(false)
+	{}
+
+	/** server's path following request the path belongs to */
+	UPROPERTY()
+	uint32 MoveId;
+
+	/** index of server path's first point client keeps, points before it were passed by the pawn */
+	UPROPERTY()
+	int32 StartIndex;
+
+	/** index of the first point replaced by PathPoints, points from StartIndex up to it are kept from the previous update of the same move */
+	UPROPERTY()
+	int32 FirstPointIndex;
+
+	UPROPERTY()
+	TArray<FVector> PathPoints;
+
+	UPROPERTY()
+	bool bPartial;
+
+	/** @return Location snapped to the precision points are replicated with */
+	static FVector Quantize(const FVector& Location) { return FVector(FMath::RoundToDouble(Location.X), FMath::RoundToDouble(Location.Y), FMath::RoundToDouble(Location.Z)); }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPlayerMoveNetPath> : public TStructOpsTypeTraitsBase2<FPlayerMoveNetPath>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
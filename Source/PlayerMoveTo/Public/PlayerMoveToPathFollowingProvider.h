@@ -0,0 +1,29 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PlayerMoveToPathFollowingProvider.generated.h"
+
+class UPathFollowingComponent;
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UPlayerMoveToPathFollowingProvider : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by controllers that keep their own path following component, so player moves use it directly
+ * instead of searching the controller's components on every activation
+ * APlayerAIMoveToController implements it, controllers that can't inherit from it can implement it themselves
+ */
+class PLAYERMOVETO_API IPlayerMoveToPathFollowingProvider
+{
+	GENERATED_BODY()
+
+public:
+	/** @return path following component used by player moves, nullptr to fall back to searching the controller's components */
+	virtual UPathFollowingComponent* GetPlayerPathFollowingComponent() const = 0;
+};
@@ -0,0 +1,83 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "Tasks/Task.h"
+#include "PlayerMoveToQuerySubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Runs path searches of player move requests on task graph workers, so concurrent moves scale across cores
+ * instead of serializing on the game thread
+ *
+ * Recast path searches only read navigation data, which is only modified while the navigation system ticks:
+ * searches are started after it ticked and all of them are joined at the end of the same world tick,
+ * requests made before the navigation system ticked wait for it
+ * Navigation data of each running search holds its batch query lock until the search is joined. Game code that
+ * rebuilds navigation synchronously during actor tick (e.g. UNavigationSystemV1::Build) has to call JoinQueries first
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UPlayerMoveToQuerySubsystem();
+
+	static UPlayerMoveToQuerySubsystem* Get(const UWorld* World);
+
+	/** Queue path search, Delegate is executed on game thread once it is done
+	 *  @return ID of the query, or INVALID_NAVQUERYID if it can't be run
+	 */
+	uint32 FindPathAsync(const FPathFindingQuery& Query, const FNavPathQueryDelegate& Delegate);
+
+	/** Delegate of query won't be executed, search that is already running is still waited for */
+	void AbortQuery(uint32 QueryID);
+
+	/** wait for all running searches and deliver their results */
+	void JoinQueries();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+protected:
+	struct FWorkerQuery
+	{
+		uint32 QueryID = INVALID_NAVQUERYID;
+		FPathFindingQuery Query;
+		FNavPathQueryDelegate OnDoneDelegate;
+		UE::Tasks::TTask<FPathFindingResult> Task;
+
+		/** navigation data whose batch query lock is held while the search runs */
+		TWeakObjectPtr<const ANavigationData> LockedNavData;
+	};
+
+	/** queries waiting for navigation system to tick */
+	TArray<FWorkerQuery> PendingQueries;
+
+	/** queries with a search in flight */
+	TArray<FWorkerQuery> RunningQueries;
+
+	FDelegateHandle PreActorTickHandle;
+
+	uint32 NextQueryID;
+
+	/** true between navigation system's tick and end of world tick, navigation data isn't modified in that window */
+	bool bCanRunQueries;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void OnWorldPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void LaunchQuery(FWorkerQuery& WorkerQuery);
+
+	/** wait for search of WorkerQuery and release the lock it holds */
+	static void WaitForQuery(FWorkerQuery& WorkerQuery);
+};
@@ -0,0 +1,115 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlayerMoveToCacheSubsystem.h"
+#include "PlayerMoveToReachabilitySubsystem.generated.h"
+
+class APlayerController;
+class UNavigationQueryFilter;
+
+/**
+ * How much a reachability query finds out, cheaper tests leave path length and cost unknown
+ */
+UENUM(BlueprintType)
+enum class EPlayerMoveReachabilityTest : uint8
+{
+	/** full path search, gives path length and cost */
+	PathLength,
+	/** path search that only tests if the goal can be reached */
+	Reachable,
+	/** reachability test on navigation's cluster graph, cheapest but coarse */
+	Hierarchical,
+};
+
+/**
+ * Result of a reachability query
+ */
+USTRUCT(BlueprintType)
+struct PLAYERMOVETO_API FPlayerMoveReachability
+{
+	GENERATED_BODY()
+
+	FPlayerMoveReachability()
+		: bReachable(false)
+		, PathLength(-1.f)
+		, PathCost(-1.f)
+	{}
+
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	bool bReachable;
+
+	/** length of path to the goal, -1 if unreachable or not tested */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	float PathLength;
+
+	/** cost of path to the goal, -1 if unreachable or not tested */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	float PathCost;
+};
+
+/**
+ * Answers whether player could move somewhere and how far it is without starting a move, e.g. for interaction prompts
+ * No task or path following request is made and results are cached for a short time, so the same prompts
+ * can be evaluated every frame
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToReachabilitySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPlayerMoveToReachabilitySubsystem* Get(const UWorld* World);
+
+	/** Test if Controller's pawn can reach GoalLocation or GoalActor */
+	UFUNCTION(BlueprintCallable, Category = "PlayerMoveTo", meta = (AdvancedDisplay = "FilterClass"))
+	FPlayerMoveReachability TestReachability(APlayerController* Controller, FVector GoalLocation, AActor* GoalActor = nullptr,
+		EPlayerMoveReachabilityTest Test = EPlayerMoveReachabilityTest::PathLength, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+
+	/** Test several goals at once, uncached ones are searched in parallel
+	 *  @return one result per goal, GoalLocations followed by GoalActors
+	 */
+	UFUNCTION(BlueprintCallable, Category = "PlayerMoveTo", meta = (AdvancedDisplay = "FilterClass", AutoCreateRefTerm = "GoalLocations,GoalActors"))
+	TArray<FPlayerMoveReachability> TestReachabilityBatch(APlayerController* Controller, const TArray<FVector>& GoalLocations, const TArray<AActor*>& GoalActors,
+		EPlayerMoveReachabilityTest Test = EPlayerMoveReachabilityTest::PathLength, TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr);
+
+	/** drop all cached results */
+	UFUNCTION(BlueprintCallable, Category = "PlayerMoveTo")
+	void FlushResults() { ResultCache.Reset(); }
+
+	uint32 GetNumHits() const { return NumHits; }
+	uint32 GetNumMisses() const { return NumMisses; }
+
+protected:
+	struct FResultKey
+	{
+		FPlayerMovePathCacheKey PathKey;
+		EPlayerMoveReachabilityTest Test = EPlayerMoveReachabilityTest::PathLength;
+
+		bool operator==(const FResultKey& Other) const { return PathKey == Other.PathKey && Test == Other.Test; }
+		friend uint32 GetTypeHash(const FResultKey& Key) { return HashCombine(GetTypeHash(Key.PathKey), (uint32)Key.Test); }
+	};
+
+	struct FCachedResult
+	{
+		FPlayerMoveReachability Result;
+		double AddedTime = 0.0;
+	};
+
+	TMap<FResultKey, FCachedResult> ResultCache;
+
+	uint32 NumHits = 0;
+	uint32 NumMisses = 0;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** @return true if Key was found in cache, path length results answer the cheaper tests too */
+	bool FindResult(const FResultKey& Key, FPlayerMoveReachability& OutResult);
+
+	void AddResult(const FResultKey& Key, const FPlayerMoveReachability& Result);
+
+	/** run the test, thread safe as it only reads navigation data */
+	static FPlayerMoveReachability RunTest(const FPathFindingQuery& Query, EPlayerMoveReachabilityTest Test);
+};
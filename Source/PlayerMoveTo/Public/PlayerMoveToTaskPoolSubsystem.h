@@ -0,0 +1,41 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlayerMoveToTaskPoolSubsystem.generated.h"
+
+class UPlayerAITask_MoveTo;
+
+/**
+ * Keeps finished UPlayerAITask_MoveTo for reuse, so frequent moves (click to move, auto run) don't create
+ * a new task for each request and garbage collection doesn't scale with how often players move
+ *
+ * Pooled tasks are reset and handed out again once they ended, don't keep references to them after
+ * OnMoveFinished or OnRequestFailed
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToTaskPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @return pool for World or nullptr if pooling is disabled */
+	static UPlayerMoveToTaskPoolSubsystem* Get(const UWorld* World);
+
+	/** @return task from the pool or a new one if the pool is empty */
+	UPlayerAITask_MoveTo* AcquireTask();
+
+	/** return task that ended, it is dropped when the pool is full */
+	void ReleaseTask(UPlayerAITask_MoveTo* Task);
+
+	int32 GetNumFreeTasks() const { return FreeTasks.Num(); }
+
+protected:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UPlayerAITask_MoveTo>> FreeTasks;
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,104 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "PlayerMoveToTelemetrySubsystem.generated.h"
+
+/**
+ * What happened during a single player move, recorded by FPlayerMoveToDriver
+ */
+USTRUCT(BlueprintType)
+struct PLAYERMOVETO_API FPlayerMoveTelemetry
+{
+	GENERATED_BODY()
+
+	FPlayerMoveTelemetry()
+		: GoalLocation(FVector::ZeroVector)
+		, TimeToFirstPath(-1.f)
+		, Duration(0.f)
+		, NumRepaths(0)
+		, NumRetries(0)
+		, PathLength(0.f)
+		, NumPathPoints(0)
+		, bPartialPath(false)
+		, Result(EPathFollowingResult::Invalid)
+	{}
+
+	/** goal of the move, actor's location at the time it finished for move to actor requests */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	FVector GoalLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	FName GoalActorName;
+
+	/** real time between activation and first path being followed in seconds, -1 if no path was found */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	float TimeToFirstPath;
+
+	/** game time between activation and finish in seconds */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	float Duration;
+
+	/** path updates due to navigation changes or goal actor moving */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	int32 NumRepaths;
+
+	/** times move or repath was postponed because controller's ShouldPostponePathUpdates */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	int32 NumRetries;
+
+	/** length of last followed path */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	float PathLength;
+
+	/** point count of last followed path */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	int32 NumPathPoints;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	bool bPartialPath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerMoveTo")
+	TEnumAsByte<EPathFollowingResult::Type> Result;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPlayerMoveTelemetrySignature, const FPlayerMoveTelemetry&, Telemetry);
+
+/**
+ * Keeps telemetry of the most recent player moves in a ring buffer, for finding interaction points
+ * that cause repath loops or long stalls in live sessions
+ */
+UCLASS()
+class PLAYERMOVETO_API UPlayerMoveToTelemetrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @return telemetry for World or nullptr if telemetry is disabled */
+	static UPlayerMoveToTelemetrySubsystem* Get(const UWorld* World);
+
+	/** store record of a finished move */
+	void AddRecord(const FPlayerMoveTelemetry& Record);
+
+	/** @return buffered records, oldest first */
+	UFUNCTION(BlueprintCallable, Category = "PlayerMoveTo")
+	TArray<FPlayerMoveTelemetry> GetRecords() const;
+
+	UFUNCTION(BlueprintCallable, Category = "PlayerMoveTo")
+	void ClearRecords();
+
+	/** executed for every recorded move */
+	UPROPERTY(BlueprintAssignable)
+	FPlayerMoveTelemetrySignature OnMoveRecorded;
+
+protected:
+	TArray<FPlayerMoveTelemetry> Records;
+
+	/** index the next record is written to once the buffer is full */
+	int32 NextRecordIndex = 0;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
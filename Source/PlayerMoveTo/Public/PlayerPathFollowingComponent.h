@@ -0,0 +1,49 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "PlayerPathFollowingComponent.generated.h"
+
+/**
+ * Path following for player pawns that steers through movement input instead of requesting path or direct moves
+ * from the movement component, so moves go through the same client prediction and root motion as player input
+ * and don't cause server corrections on autonomous proxies
+ *
+ * Steers towards a point a little ahead on the path to round corners, and ramps input down when approaching the goal
+ * Set as PathFollowingComponentClass of APlayerAIMoveToController to use it
+ *
+ * Only steers moves run where the pawn is locally controlled: client predicted moves, and local players of listen
+ * servers and standalone games. Server driven moves of remote players use regular path following, since the server
+ * doesn't consume their movement input
+ */
+UCLASS(BlueprintType)
+class PLAYERMOVETO_API UPlayerPathFollowingComponent : public UPathFollowingComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPlayerPathFollowingComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** distance ahead on the path pawn steers towards, rounds corners, 0 follows path segments exactly */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0", ForceUnits = "cm"))
+	float CornerLookAhead;
+
+	/** distance from the goal input starts ramping down, 0 keeps full input until the end */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", UIMin = "0", ForceUnits = "cm"))
+	float ApproachDistance;
+
+	/** input scale at the goal */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PlayerMoveTo", meta = (ClampMin = "0", ClampMax = "1", UIMin = "0", UIMax = "1"))
+	float MinApproachInputScale;
+
+protected:
+	virtual void FollowPathSegment(float DeltaTime) override;
+
+	/** @return location Distance ahead of Location along the path, starting with the current segment */
+	FVector GetLookAheadLocation(const FVector& Location, float Distance) const;
+
+	/** @return input scale for DistanceToGoal, only applies on the last path segment */
+	float GetApproachInputScale(float DistanceToGoal) const;
+};
@@ -0,0 +1,25 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+using UnrealBuildTool;
+
+public class PlayerMoveToTests : ModuleRules
+{
+	public PlayerMoveToTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"NavigationSystem",
+				"AIModule",
+				"GameplayTasks",
+				"UnrealEd",
+				"PlayerMoveTo",
+			}
+			);
+	}
+}
@@ -0,0 +1,284 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PlayerMoveToTestWorld.h"
+#include "PlayerAITask_MoveTo.h"
+#include "PlayerAIMoveToController.h"
+#include "PlayerMoveToCacheSubsystem.h"
+#include "PlayerMoveToDriver.h"
+
+#include "GameFramework/Pawn.h"
+#include "Misc/AutomationTest.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+
+/**
+ * Benchmarks of player move requests on a generated navmesh, results are written as CSV and JSON to Saved/Profiling/PlayerMoveTo
+ * Run headless: UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests PlayerMoveTo.Benchmark; Quit"
+ * Scale with -PlayerMoveToAgents=N -PlayerMoveToIterations=N
+ */
+namespace PlayerMoveToTests
+{
+	static constexpr float GoalRadius = 5000.f;
+
+	struct FSummary
+	{
+		double Avg = 0.0;
+		double P50 = 0.0;
+		double P95 = 0.0;
+		double Max = 0.0;
+	};
+
+	static FSummary Summarize(TArray<double> Values)
+	{
+		FSummary Summary;
+		if (Values.Num() > 0)
+		{
+			Values.Sort();
+			double Total = 0.0;
+			for (const double Value : Values)
+			{
+				Total += Value;
+			}
+
+			Summary.Avg = Total / Values.Num();
+			Summary.P50 = Values[(Values.Num() - 1) / 2];
+			Summary.P95 = Values[FMath::Min(Values.Num() - 1, FMath::FloorToInt(Values.Num() * 0.95))];
+			Summary.Max = Values.Last();
+		}
+		return Summary;
+	}
+
+	static FString SummaryToJson(const TCHAR* Name, const FSummary& Summary)
+	{
+		return FString::Printf(TEXT("\"%s\": { \"avg\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"max\": %.4f }"), Name, Summary.Avg, Summary.P50, Summary.P95, Summary.Max);
+	}
+
+	static bool FindGoal(const FPlayerMoveToTestWorld& TestWorld, const APlayerAIMoveToController& Controller, FVector& OutGoal)
+	{
+		FNavLocation Goal;
+		if (Controller.GetPawn() && TestWorld.GetNavigationSystem()->GetRandomReachablePointInRadius(Controller.GetPawn()->GetActorLocation(), GoalRadius, Goal))
+		{
+			OutGoal = Goal.Location;
+			return true;
+		}
+		return false;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerMoveToPerformMoveBenchmark, "PlayerMoveTo.Benchmark.PerformMove",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPlayerMoveToPerformMoveBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumAgents = PlayerMoveToTests::GetCommandLineInt(TEXT("PlayerMoveToAgents"), 16);
+	const int32 NumIterations = PlayerMoveToTests::GetCommandLineInt(TEXT("PlayerMoveToIterations"), 100);
+
+	FPlayerMoveToTestWorld TestWorld(NumAgents);
+	if (!TestTrue(TEXT("Test world has navigation and agents"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	const PlayerMoveToTests::FScopedSyncPathfinding SyncPathfinding;
+
+	TArray<double> PerformMoveMs;
+	TArray<double> RepathMs;
+	int32 NumPathsFound = 0;
+	FString Csv = TEXT("Iteration,Agent,PerformMoveMs,RepathMs,PathFound,Partial,PathPoints,PathLength\n");
+	FString JsonSamples;
+
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (int32 Agent = 0; Agent < TestWorld.GetControllers().Num(); Agent++)
+		{
+			APlayerAIMoveToController* Controller = TestWorld.GetControllers()[Agent];
+			FVector Goal;
+			UPlayerAITask_MoveTo* Task = PlayerMoveToTests::FindGoal(TestWorld, *Controller, Goal) ? UPlayerAITask_MoveTo::PlayerAIMoveTo(Controller, Goal) : nullptr;
+			if (Task == nullptr)
+			{
+				continue;
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			Task->ReadyForActivation();
+			const double SamplePerformMoveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			PerformMoveMs.Add(SamplePerformMoveMs);
+
+			// same search navigation system performs when it repaths an invalidated path
+			double SampleRepathMs = 0.0;
+			const FNavPathSharedPtr Path = Task->GetPath();
+			const bool bPathFound = Path.IsValid() && Path->IsValid();
+			if (bPathFound && Path->GetNavigationDataUsed())
+			{
+				NumPathsFound++;
+				const FPathFindingQuery RepathQuery(Path.ToSharedRef());
+				StartTime = FPlatformTime::Seconds();
+				Path->GetNavigationDataUsed()->FindPath(RepathQuery.NavAgentProperties, RepathQuery);
+				SampleRepathMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+				RepathMs.Add(SampleRepathMs);
+			}
+
+			const int32 PathPoints = bPathFound ? Path->GetPathPoints().Num() : 0;
+			const float PathLength = bPathFound ? Path->GetLength() : 0.f;
+			const bool bPartial = bPathFound && Path->IsPartial();
+			Csv += FString::Printf(TEXT("%d,%d,%.4f,%.4f,%d,%d,%d,%.1f\n"), Iteration, Agent, SamplePerformMoveMs, SampleRepathMs, bPathFound ? 1 : 0, bPartial ? 1 : 0, PathPoints, PathLength);
+			JsonSamples += FString::Printf(TEXT("%s\n\t\t{ \"iteration\": %d, \"agent\": %d, \"performMoveMs\": %.4f, \"repathMs\": %.4f, \"pathFound\": %s, \"partial\": %s, \"pathPoints\": %d, \"pathLength\": %.1f }"),
+				JsonSamples.IsEmpty() ? TEXT("") : TEXT(","), Iteration, Agent, SamplePerformMoveMs, SampleRepathMs,
+				bPathFound ? TEXT("true") : TEXT("false"), bPartial ? TEXT("true") : TEXT("false"), PathPoints, PathLength);
+
+			Task->ExternalCancel();
+		}
+	}
+
+	const PlayerMoveToTests::FSummary PerformMove = PlayerMoveToTests::Summarize(PerformMoveMs);
+	const PlayerMoveToTests::FSummary Repath = PlayerMoveToTests::Summarize(RepathMs);
+	AddInfo(FString::Printf(TEXT("%d requests, %d paths found"), PerformMoveMs.Num(), NumPathsFound));
+	AddInfo(FString::Printf(TEXT("PerformMove ms: avg %.4f p50 %.4f p95 %.4f max %.4f"), PerformMove.Avg, PerformMove.P50, PerformMove.P95, PerformMove.Max));
+	AddInfo(FString::Printf(TEXT("Repath ms: avg %.4f p50 %.4f p95 %.4f max %.4f"), Repath.Avg, Repath.P50, Repath.P95, Repath.Max));
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"requests\": %d,\n\t\"agents\": %d,\n\t\"iterations\": %d,\n\t\"pathsFound\": %d,\n"), PerformMoveMs.Num(), TestWorld.GetControllers().Num(), NumIterations, NumPathsFound);
+	Json += FString::Printf(TEXT("\t\"pathCache\": %s,\n"), UPlayerMoveToCacheSubsystem::Get(TestWorld.GetWorld()) ? TEXT("true") : TEXT("false"));
+	Json += TEXT("\t") + PlayerMoveToTests::SummaryToJson(TEXT("performMoveMs"), PerformMove) + TEXT(",\n");
+	Json += TEXT("\t") + PlayerMoveToTests::SummaryToJson(TEXT("repathMs"), Repath) + TEXT(",\n");
+	Json += TEXT("\t\"samples\": [") + JsonSamples + TEXT("\n\t]\n}\n");
+	AddInfo(FString::Printf(TEXT("Results written to %s.csv/.json"), *PlayerMoveToTests::WriteResults(TEXT("PerformMove"), Csv, Json)));
+
+	return TestTrue(TEXT("Paths were found"), NumPathsFound > 0);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerMoveToActiveTaskMemoryBenchmark, "PlayerMoveTo.Benchmark.ActiveTaskMemory",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPlayerMoveToActiveTaskMemoryBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumAgents = PlayerMoveToTests::GetCommandLineInt(TEXT("PlayerMoveToAgents"), 256);
+
+	FPlayerMoveToTestWorld TestWorld(NumAgents);
+	if (!TestTrue(TEXT("Test world has navigation and agents"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	const PlayerMoveToTests::FScopedSyncPathfinding SyncPathfinding;
+
+	// goals are picked up front, so the tasks are created back to back
+	TArray<TPair<APlayerAIMoveToController*, FVector>> Moves;
+	for (APlayerAIMoveToController* Controller : TestWorld.GetControllers())
+	{
+		FVector Goal;
+		if (PlayerMoveToTests::FindGoal(TestWorld, *Controller, Goal))
+		{
+			Moves.Emplace(Controller, Goal);
+		}
+	}
+
+	// one move per agent, all of them active at the same time
+	TArray<UPlayerAITask_MoveTo*> Tasks;
+	Tasks.Reserve(Moves.Num());
+	for (const TPair<APlayerAIMoveToController*, FVector>& Move : Moves)
+	{
+		if (UPlayerAITask_MoveTo* Task = UPlayerAITask_MoveTo::PlayerAIMoveTo(Move.Key, Move.Value))
+		{
+			Task->ReadyForActivation();
+			Tasks.Add(Task);
+		}
+	}
+
+	// memory of the tasks themselves: task object with its driver, heap owned by the driver and the followed path,
+	// path following component belongs to the controller and exists without a task, it isn't included
+	TArray<double> TaskBytes;
+	FString Csv = TEXT("Task,ObjectBytes,DriverBytes,PathBytes,TotalBytes\n");
+	for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); TaskIndex++)
+	{
+		const UPlayerAITask_MoveTo* Task = Tasks[TaskIndex];
+		if (!Task->IsActive())
+		{
+			continue;
+		}
+
+		const SIZE_T ObjectBytes = Task->GetClass()->GetStructureSize();
+		const SIZE_T DriverBytes = Task->GetAllocatedSize();
+		const SIZE_T PathBytes = Task->GetPath().IsValid() ? FPlayerMoveToDriver::GetPathAllocatedSize(*Task->GetPath()) : 0;
+		const SIZE_T TotalBytes = ObjectBytes + DriverBytes + PathBytes;
+		TaskBytes.Add((double)TotalBytes);
+		Csv += FString::Printf(TEXT("%d,%llu,%llu,%llu,%llu\n"), TaskIndex, (uint64)ObjectBytes, (uint64)DriverBytes, (uint64)PathBytes, (uint64)TotalBytes);
+	}
+
+	const int32 NumActive = TaskBytes.Num();
+	const PlayerMoveToTests::FSummary BytesPerTask = PlayerMoveToTests::Summarize(TaskBytes);
+	AddInfo(FString::Printf(TEXT("%d active tasks, bytes per task: avg %.0f p50 %.0f p95 %.0f max %.0f"), NumActive, BytesPerTask.Avg, BytesPerTask.P50, BytesPerTask.P95, BytesPerTask.Max));
+
+	for (UPlayerAITask_MoveTo* Task : Tasks)
+	{
+		Task->ExternalCancel();
+	}
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"activeTasks\": %d,\n"), NumActive);
+	Json += TEXT("\t") + PlayerMoveToTests::SummaryToJson(TEXT("bytesPerTask"), BytesPerTask) + TEXT("\n}\n");
+	AddInfo(FString::Printf(TEXT("Results written to %s.csv/.json"), *PlayerMoveToTests::WriteResults(TEXT("ActiveTaskMemory"), Csv, Json)));
+
+	return TestTrue(TEXT("Tasks were active"), NumActive > 0);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerMoveToTaskThroughputBenchmark, "PlayerMoveTo.Benchmark.TaskThroughput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPlayerMoveToTaskThroughputBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumAgents = PlayerMoveToTests::GetCommandLineInt(TEXT("PlayerMoveToAgents"), 16);
+	const int32 NumIterations = PlayerMoveToTests::GetCommandLineInt(TEXT("PlayerMoveToIterations"), 100);
+
+	FPlayerMoveToTestWorld TestWorld(NumAgents);
+	if (!TestTrue(TEXT("Test world has navigation and agents"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	// tasks are never activated, only creation and destruction of them is measured
+	TArray<double> CreateMs;
+	TArray<double> DestroyMs;
+	FString Csv = TEXT("Iteration,Agent,CreateMs,DestroyMs\n");
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (int32 Agent = 0; Agent < TestWorld.GetControllers().Num(); Agent++)
+		{
+			APlayerAIMoveToController* Controller = TestWorld.GetControllers()[Agent];
+			const APawn* Pawn = Controller->GetPawn();
+			if (Pawn == nullptr)
+			{
+				continue;
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			UPlayerAITask_MoveTo* Task = UPlayerAITask_MoveTo::PlayerAIMoveTo(Controller, Pawn->GetActorLocation());
+			const double SampleCreateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			if (Task == nullptr)
+			{
+				continue;
+			}
+
+			StartTime = FPlatformTime::Seconds();
+			Task->ExternalCancel();
+			const double SampleDestroyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			CreateMs.Add(SampleCreateMs);
+			DestroyMs.Add(SampleDestroyMs);
+			Csv += FString::Printf(TEXT("%d,%d,%.4f,%.4f\n"), Iteration, Agent, SampleCreateMs, SampleDestroyMs);
+		}
+	}
+
+	const PlayerMoveToTests::FSummary Create = PlayerMoveToTests::Summarize(CreateMs);
+	const PlayerMoveToTests::FSummary Destroy = PlayerMoveToTests::Summarize(DestroyMs);
+	const double TasksPerSecond = Create.Avg + Destroy.Avg > 0.0 ? 1000.0 / (Create.Avg + Destroy.Avg) : 0.0;
+	AddInfo(FString::Printf(TEXT("Create ms: avg %.4f, Destroy ms: avg %.4f, %.1f tasks/s"), Create.Avg, Destroy.Avg, TasksPerSecond));
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"tasks\": %d,\n\t\"tasksPerSecond\": %.1f,\n"), CreateMs.Num(), TasksPerSecond);
+	Json += TEXT("\t") + PlayerMoveToTests::SummaryToJson(TEXT("createMs"), Create) + TEXT(",\n");
+	Json += TEXT("\t") + PlayerMoveToTests::SummaryToJson(TEXT("destroyMs"), Destroy) + TEXT("\n}\n");
+	AddInfo(FString::Printf(TEXT("Results written to %s.csv/.json"), *PlayerMoveToTests::WriteResults(TEXT("TaskThroughput"), Csv, Json)));
+
+	return TestTrue(TEXT("Tasks were created"), CreateMs.Num() > 0);
+}
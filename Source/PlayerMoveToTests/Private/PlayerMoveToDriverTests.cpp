@@ -0,0 +1,147 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PlayerMoveToTestWorld.h"
+#include "PlayerAITask_MoveTo.h"
+#include "PlayerAIMoveToController.h"
+
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "Misc/AutomationTest.h"
+#include "NavigationSystem.h"
+#include "Tasks/GameplayTask_WaitDelay.h"
+
+/**
+ * Behavior of FPlayerMoveToDriver and move tasks on a generated navmesh
+ * Run headless: UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests PlayerMoveTo.Driver; Quit"
+ */
+namespace PlayerMoveToTests
+{
+	static constexpr float TickInterval = 0.05f;
+
+	/** @return reachable location at least MinDistance away from Origin */
+	static bool FindDistantLocation(const FPlayerMoveToTestWorld& TestWorld, const FVector& Origin, float MinDistance, FVector& OutLocation)
+	{
+		for (int32 Attempt = 0; Attempt < 32; Attempt++)
+		{
+			FNavLocation Location;
+			if (TestWorld.GetNavigationSystem()->GetRandomReachablePointInRadius(Origin, MinDistance * 2.f, Location) && FVector::Dist2D(Origin, Location.Location) >= MinDistance)
+			{
+				OutLocation = Location.Location;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void TickWorld(const FPlayerMoveToTestWorld& TestWorld, float Seconds)
+	{
+		for (float Time = 0.f; Time < Seconds; Time += TickInterval)
+		{
+			TestWorld.GetWorld()->Tick(LEVELTICK_All, TickInterval);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerMoveToPauseResumeGoalTrackingTest, "PlayerMoveTo.Driver.PauseResumeGoalTracking",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPlayerMoveToPauseResumeGoalTrackingTest::RunTest(const FString& Parameters)
+{
+	FPlayerMoveToTestWorld TestWorld(1);
+	if (!TestTrue(TEXT("Test world has navigation and agents"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	const PlayerMoveToTests::FScopedSyncPathfinding SyncPathfinding;
+
+	// goal far enough that the pawn doesn't reach it while the test runs
+	APlayerAIMoveToController* Controller = TestWorld.GetControllers()[0];
+	const FVector PawnLocation = Controller->GetPawn()->GetActorLocation();
+	FVector GoalLocation;
+	FVector MovedGoalLocation;
+	if (!TestTrue(TEXT("Goal locations found"), PlayerMoveToTests::FindDistantLocation(TestWorld, PawnLocation, 4000.f, GoalLocation) &&
+		PlayerMoveToTests::FindDistantLocation(TestWorld, GoalLocation, 1000.f, MovedGoalLocation)))
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* GoalActor = TestWorld.GetWorld()->SpawnActor<ADefaultPawn>(GoalLocation, FRotator::ZeroRotator, SpawnParams);
+
+	UPlayerAITask_MoveTo* Task = GoalActor ? UPlayerAITask_MoveTo::PlayerAIMoveTo(Controller, GoalLocation, GoalActor) : nullptr;
+	if (!TestNotNull(TEXT("Move task"), Task))
+	{
+		return false;
+	}
+
+	Task->ReadyForActivation();
+	TestTrue(TEXT("Task is active"), Task->IsActive());
+
+	Task->PauseInTaskQueue();
+	TestTrue(TEXT("Task is paused"), Task->IsPaused());
+	PlayerMoveToTests::TickWorld(TestWorld, 0.2f);
+
+	Task->ActivateInTaskQueue();
+	TestTrue(TEXT("Task is active after resume"), Task->IsActive());
+
+	// goal observation has to run again after resume
+	const int32 NumRepaths = Task->GetTelemetry().NumRepaths;
+	GoalActor->SetActorLocation(MovedGoalLocation);
+	PlayerMoveToTests::TickWorld(TestWorld, 1.f);
+
+	TestTrue(TEXT("Task is still active"), Task->IsActive());
+	TestTrue(TEXT("Path was updated after goal actor moved"), Task->GetTelemetry().NumRepaths > NumRepaths);
+
+	Task->ExternalCancel();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerMoveToPooledTaskChildTest, "PlayerMoveTo.Driver.PooledTaskEndsChildTask",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPlayerMoveToPooledTaskChildTest::RunTest(const FString& Parameters)
+{
+	FPlayerMoveToTestWorld TestWorld(1);
+	if (!TestTrue(TEXT("Test world has navigation and agents"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	const PlayerMoveToTests::FScopedSyncPathfinding SyncPathfinding;
+	const PlayerMoveToTests::FScopedConsoleVariable TaskPoolSize(TEXT("PlayerMoveTo.TaskPool.Size"), 4);
+
+	APlayerAIMoveToController* Controller = TestWorld.GetControllers()[0];
+	FVector GoalLocation;
+	if (!TestTrue(TEXT("Goal location found"), PlayerMoveToTests::FindDistantLocation(TestWorld, Controller->GetPawn()->GetActorLocation(), 2000.f, GoalLocation)))
+	{
+		return false;
+	}
+
+	UPlayerAITask_MoveTo* Task = UPlayerAITask_MoveTo::PlayerAIMoveTo(Controller, GoalLocation);
+	if (!TestNotNull(TEXT("Move task"), Task))
+	{
+		return false;
+	}
+
+	Task->ReadyForActivation();
+	TestTrue(TEXT("Task is active"), Task->IsActive());
+
+	// task owned by the move task becomes its child
+	UGameplayTask_WaitDelay* ChildTask = UGameplayTask_WaitDelay::TaskWaitDelay(TScriptInterface<IGameplayTaskOwnerInterface>(Task), 60.f);
+	if (!TestNotNull(TEXT("Child task"), ChildTask))
+	{
+		Task->ExternalCancel();
+		return false;
+	}
+
+	ChildTask->ReadyForActivation();
+	TestTrue(TEXT("Child task is active"), ChildTask->IsActive());
+
+	// pooled task skips UGameplayTask::OnDestroy, its child has to end anyway
+	Task->ExternalCancel();
+	TestTrue(TEXT("Child task ended with pooled task"), ChildTask->IsFinished());
+
+	return true;
+}
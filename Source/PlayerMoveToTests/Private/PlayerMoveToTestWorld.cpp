@@ -0,0 +1,202 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PlayerMoveToTestWorld.h"
+#include "PlayerAIMoveToController.h"
+
+#include "ActorFactories/ActorFactory.h"
+#include "Builders/CubeBuilder.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "NavMesh/RecastNavMesh.h"
+
+namespace PlayerMoveToTests
+{
+	static const TCHAR* CubeMeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+
+	/** engine cube is 100 units wide */
+	static constexpr float CubeSize = 100.f;
+
+	static constexpr float PillarSpacing = 1500.f;
+
+	/** RuntimeGeneration isn't exposed, it is only set through config and details panel */
+	static FByteProperty* GetRuntimeGenerationProperty(FEnumProperty*& OutEnumProperty)
+	{
+		OutEnumProperty = CastField<FEnumProperty>(ANavigationData::StaticClass()->FindPropertyByName(TEXT("RuntimeGeneration")));
+		return OutEnumProperty ? CastField<FByteProperty>(OutEnumProperty->GetUnderlyingProperty()) : nullptr;
+	}
+
+	int32 GetCommandLineInt(const TCHAR* Name, int32 Default)
+	{
+		int32 Value = Default;
+		FParse::Value(FCommandLine::Get(), *FString::Printf(TEXT("%s="), Name), Value);
+		return Value;
+	}
+
+	FString WriteResults(const FString& TestName, const FString& Csv, const FString& Json)
+	{
+		const FString BaseName = FPaths::ProfilingDir() / TEXT("PlayerMoveTo") / FString::Printf(TEXT("%s-%s"), *TestName, *FDateTime::Now().ToString());
+		FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json")));
+		return FPaths::ConvertRelativePathToFull(BaseName);
+	}
+
+	FScopedConsoleVariable::FScopedConsoleVariable(const TCHAR* Name, int32 Value)
+		: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		, PrevValue(CVar ? CVar->GetInt() : 0)
+	{
+		if (CVar)
+		{
+			CVar->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	FScopedConsoleVariable::~FScopedConsoleVariable()
+	{
+		if (CVar)
+		{
+			CVar->Set(PrevValue, ECVF_SetByCode);
+		}
+	}
+}
+
+FPlayerMoveToTestWorld::FPlayerMoveToTestWorld(int32 NumAgents, float Size)
+{
+	// game worlds don't generate static navmesh, generate it at runtime for the lifetime of this world
+	FEnumProperty* EnumProperty = nullptr;
+	if (FByteProperty* RuntimeGenerationProperty = PlayerMoveToTests::GetRuntimeGenerationProperty(EnumProperty))
+	{
+		ARecastNavMesh* NavMeshCDO = GetMutableDefault<ARecastNavMesh>();
+		void* Value = EnumProperty->ContainerPtrToValuePtr<void>(NavMeshCDO);
+		PrevRuntimeGeneration = (uint8)RuntimeGenerationProperty->GetUnsignedIntPropertyValue(Value);
+		RuntimeGenerationProperty->SetIntPropertyValue(Value, (uint64)ERuntimeGenerationType::Dynamic);
+	}
+
+	World = UWorld::CreateWorld(EWorldType::Game, false, MakeUniqueObjectName(nullptr, UWorld::StaticClass(), TEXT("PlayerMoveToTestWorld")));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	SpawnGeometry(Size);
+	BuildNavigation(Size);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	SpawnAgents(NumAgents);
+}
+
+FPlayerMoveToTestWorld::~FPlayerMoveToTestWorld()
+{
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FEnumProperty* EnumProperty = nullptr;
+	if (FByteProperty* RuntimeGenerationProperty = PlayerMoveToTests::GetRuntimeGenerationProperty(EnumProperty))
+	{
+		RuntimeGenerationProperty->SetIntPropertyValue(EnumProperty->ContainerPtrToValuePtr<void>(GetMutableDefault<ARecastNavMesh>()), (uint64)PrevRuntimeGeneration);
+	}
+}
+
+void FPlayerMoveToTestWorld::SpawnGeometry(float Size)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, PlayerMoveToTests::CubeMeshPath);
+	if (CubeMesh == nullptr)
+	{
+		return;
+	}
+
+	// mesh is set before the component is registered, static components can't change it afterwards
+	auto SpawnCube = [this, CubeMesh](const FVector& Location, const FVector& Scale)
+	{
+		AStaticMeshActor* Cube = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, Location, Scale));
+		Cube->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Cube->FinishSpawning(FTransform(FRotator::ZeroRotator, Location, Scale));
+	};
+
+	const float FloorScale = Size / PlayerMoveToTests::CubeSize;
+	SpawnCube(FVector(0.f, 0.f, -PlayerMoveToTests::CubeSize * 0.5f), FVector(FloorScale, FloorScale, 1.f));
+
+	// pillars make paths bend, every third one is left out so there are long straight corridors too
+	const int32 NumPillars = FMath::FloorToInt(Size / PlayerMoveToTests::PillarSpacing);
+	for (int32 X = 0; X < NumPillars; X++)
+	{
+		for (int32 Y = 0; Y < NumPillars; Y++)
+		{
+			if ((X + Y) % 3 != 0)
+			{
+				const FVector Location((X + 0.5f) * PlayerMoveToTests::PillarSpacing - Size * 0.5f, (Y + 0.5f) * PlayerMoveToTests::PillarSpacing - Size * 0.5f, 150.f);
+				SpawnCube(Location, FVector(4.f, 4.f, 3.f));
+			}
+		}
+	}
+}
+
+void FPlayerMoveToTestWorld::BuildNavigation(float Size)
+{
+	ANavMeshBoundsVolume* BoundsVolume = World->SpawnActor<ANavMeshBoundsVolume>();
+	UCubeBuilder* BoundsBuilder = NewObject<UCubeBuilder>();
+	BoundsBuilder->X = Size;
+	BoundsBuilder->Y = Size;
+	BoundsBuilder->Z = 1000.f;
+	UActorFactory::CreateBrushForVolumeActor(BoundsVolume, BoundsBuilder);
+
+	FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::GameMode);
+	NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (NavSys == nullptr)
+	{
+		return;
+	}
+
+	// blocks until all tiles are generated
+	NavSys->OnNavigationBoundsUpdated(BoundsVolume);
+	NavSys->Build();
+
+	if (NavSys->GetDefaultNavDataInstance() == nullptr)
+	{
+		NavSys = nullptr;
+	}
+}
+
+void FPlayerMoveToTestWorld::SpawnAgents(int32 NumAgents)
+{
+	if (NavSys == nullptr)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Agent = 0; Agent < NumAgents; Agent++)
+	{
+		FNavLocation SpawnLocation;
+		if (!NavSys->GetRandomPoint(SpawnLocation))
+		{
+			continue;
+		}
+
+		APawn* Pawn = World->SpawnActor<ADefaultPawn>(SpawnLocation.Location + FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+		APlayerAIMoveToController* Controller = Pawn ? World->SpawnActor<APlayerAIMoveToController>(SpawnParams) : nullptr;
+		if (Controller)
+		{
+			Controller->Possess(Pawn);
+			Controllers.Add(Controller);
+		}
+		else if (Pawn)
+		{
+			Pawn->Destroy();
+		}
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerAIMoveToController;
+class IConsoleVariable;
+class UNavigationSystemV1;
+class UWorld;
+
+/**
+ * Game world built for tests: flat floor with a grid of pillars, navmesh generated over it and player controllers
+ * possessing pawns at random navigable locations. Doesn't need any map or content besides engine basic shapes
+ * World is destroyed with this object
+ */
+class FPlayerMoveToTestWorld
+{
+public:
+	/** @param Size - width of the floor */
+	FPlayerMoveToTestWorld(int32 NumAgents, float Size = 20000.f);
+	~FPlayerMoveToTestWorld();
+
+	/** true if navmesh was built and at least one agent was spawned */
+	bool IsValid() const { return World != nullptr && NavSys != nullptr && Controllers.Num() > 0; }
+
+	UWorld* GetWorld() const { return World; }
+	UNavigationSystemV1* GetNavigationSystem() const { return NavSys; }
+	const TArray<APlayerAIMoveToController*>& GetControllers() const { return Controllers; }
+
+private:
+	UWorld* World = nullptr;
+	UNavigationSystemV1* NavSys = nullptr;
+	TArray<APlayerAIMoveToController*> Controllers;
+
+	/** runtime generation of navmesh class default, game worlds only build navmesh that supports it */
+	uint8 PrevRuntimeGeneration = 0;
+
+	void SpawnGeometry(float Size);
+	void BuildNavigation(float Size);
+	void SpawnAgents(int32 NumAgents);
+};
+
+namespace PlayerMoveToTests
+{
+	/** @return Default or -Name=Value from command line, so benchmarks can be scaled without recompiling */
+	int32 GetCommandLineInt(const TCHAR* Name, int32 Default);
+
+	/** write Csv and Json next to each other in Saved/Profiling/PlayerMoveTo
+	 *  @return full path of the files without extension
+	 */
+	FString WriteResults(const FString& TestName, const FString& Csv, const FString& Json);
+
+	/** set integer console variable Name to Value while in scope */
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, int32 Value);
+		~FScopedConsoleVariable();
+
+	private:
+		IConsoleVariable* CVar;
+		int32 PrevValue;
+	};
+
+	/** search paths on game thread while in scope, so PerformMove includes the path search and paths are ready right after it */
+	struct FScopedSyncPathfinding : public FScopedConsoleVariable
+	{
+		FScopedSyncPathfinding() : FScopedConsoleVariable(TEXT("PlayerMoveTo.PathfindingMode"), 1) {}
+	};
+}
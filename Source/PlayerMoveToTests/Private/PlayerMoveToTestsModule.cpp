@@ -0,0 +1,5 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, PlayerMoveToTests)